@@ -23,6 +23,7 @@
 
 #include "../cmd-core.h"
 #include "../game-world.h"
+#include "../generate.h"
 #include "../obj-gear.h"
 #include "../obj-init.h"
 #include "../obj-knowledge.h"
@@ -535,7 +536,7 @@ void reincarnate_borg(void)
 
     /* Initialise the stores, dungeon */
     store_reset();
-    chunk_list_max = 0;
+    chunk_list_free();
 
     /* Restore the standard artifacts (randarts may have been loaded) */
     cleanup_parser(&randart_parser);
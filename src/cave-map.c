@@ -18,6 +18,7 @@
 
 #include "angband.h"
 #include "cave.h"
+#include "generate.h"
 #include "init.h"
 #include "monster.h"
 #include "mon-predicate.h"
@@ -29,6 +30,7 @@
 #include "player-calcs.h"
 #include "player-timed.h"
 #include "trap.h"
+#include "z-queue.h"
 
 /**
  * This function takes a grid location and extracts information the
@@ -250,16 +252,75 @@ void square_note_spot(struct chunk *c, struct loc grid)
 /**
  * Tell the UI that a given map location has been updated
  *
+ * The grid is only marked here; the UI draws all the marked grids together
+ * the next time the map is redrawn, so a grid changed many times over is
+ * drawn once.
+ *
  * This function should only be called on "legal" grids.
  */
 void square_light_spot(struct chunk *c, struct loc grid)
 {
 	if ((c == cave) && player->cave) {
 		player->upkeep->redraw |= PR_ITEMLIST;
-		event_signal_point(EVENT_MAP, grid.x, grid.y);
+		square_mark_redraw(c, grid);
 	}
 }
 
+/**
+ * Mark a grid to be redrawn by the UI
+ */
+void square_mark_redraw(struct chunk *c, struct loc grid)
+{
+	int i = grid.y * c->width + grid.x;
+
+	c->redraw[i / 32] |= 1U << (i % 32);
+
+	/* Take in the grid */
+	if (c->redraw_br.x < c->redraw_tl.x) {
+		c->redraw_tl = grid;
+		c->redraw_br = grid;
+	} else {
+		c->redraw_tl.x = MIN(c->redraw_tl.x, grid.x);
+		c->redraw_tl.y = MIN(c->redraw_tl.y, grid.y);
+		c->redraw_br.x = MAX(c->redraw_br.x, grid.x);
+		c->redraw_br.y = MAX(c->redraw_br.y, grid.y);
+	}
+}
+
+/**
+ * True if a grid is marked to be redrawn
+ */
+bool square_isredraw(struct chunk *c, struct loc grid)
+{
+	int i = grid.y * c->width + grid.x;
+
+	return (c->redraw[i / 32] & (1U << (i % 32))) != 0;
+}
+
+/**
+ * True if any grid is marked to be redrawn
+ */
+bool cave_redraw_pending(struct chunk *c)
+{
+	return c->redraw_br.x >= c->redraw_tl.x;
+}
+
+/**
+ * Forget the marks for redrawing grids, once they have been drawn
+ */
+void cave_clear_redraw(struct chunk *c)
+{
+	int first, last;
+
+	if (!cave_redraw_pending(c)) return;
+	first = c->redraw_tl.y * c->width + c->redraw_tl.x;
+	last = c->redraw_br.y * c->width + c->redraw_br.x;
+	memset(c->redraw + first / 32, 0,
+		(last / 32 - first / 32 + 1) * sizeof(uint32_t));
+	c->redraw_tl = loc(c->width, c->height);
+	c->redraw_br = loc(0, 0);
+}
+
 
 /**
  * This routine will Perma-Light all grids in the set passed in.
@@ -657,3 +718,126 @@ void cave_known(struct player *p)
 		}
 	}
 }
+
+/**
+ * Spread noise outwards from the grids in a chunk's noise work queue.
+ *
+ * Each grid popped passes its noise, plus the increment, on to neighbouring
+ * grids which carry noise and which are either silent or louder than that.
+ * Since every step adds the same amount and the queue is first in, first out,
+ * each grid is given its final value the first time it is reached.
+ */
+static void spread_noise(struct chunk *c)
+{
+	struct noise_flow *flow = &c->noise_flow;
+
+	while (q_len(flow->queue) > 0) {
+		struct loc next;
+		int d, noise;
+
+		i_to_grid(q_pop_int(flow->queue), c->width, &next);
+		noise = c->noise.grids[next.y][next.x] + flow->increment;
+
+		for (d = 0; d < 8; d++) {
+			struct loc grid = loc_sum(next, ddgrid_ddd[d]);
+			uint16_t *old;
+
+			if (!square_in_bounds(c, grid)) continue;
+
+			/* Ignore features that don't transmit sound */
+			if (square_isnoflow(c, grid)) continue;
+
+			/* Skip the origin, which always has no noise */
+			if (loc_eq(flow->origin, grid)) continue;
+
+			/* Skip grids that are already at least as quiet */
+			old = &c->noise.grids[grid.y][grid.x];
+			if (*old != 0 && *old <= noise) continue;
+
+			*old = noise;
+			q_push_int(flow->queue, grid_to_i(grid, c->width));
+		}
+	}
+}
+
+/**
+ * Bring a chunk's noise map up to date for noise made at origin.
+ *
+ * The noise map holds, for each grid that noise can reach, increment times
+ * the number of steps noise takes to get there from origin; the origin itself
+ * and unreachable grids hold 0.  If origin and increment are the same as last
+ * time, only grids which have started carrying noise since then (an opened
+ * door, a tunnelled wall) need to be spread from, and if nothing has changed
+ * there is nothing to do.  Otherwise the map is rebuilt.
+ */
+void cave_update_noise(struct chunk *c, struct loc origin, int increment)
+{
+	struct noise_flow *flow = &c->noise_flow;
+	int i;
+
+	if (!flow->queue) {
+		flow->queue = q_new(c->height * c->width);
+	}
+
+	if (flow->increment == increment && loc_eq(flow->origin, origin)) {
+		/* Spread noise from each newly opened grid in turn */
+		for (i = 0; i < flow->opened_num; i++) {
+			struct loc grid = flow->opened[i];
+			int d, quietest = -1;
+
+			if (loc_eq(grid, origin) || square_isnoflow(c, grid))
+				continue;
+
+			/* It hears whatever its quietest neighbour does */
+			for (d = 0; d < 8; d++) {
+				struct loc adj = loc_sum(grid, ddgrid_ddd[d]);
+				int noise;
+
+				if (!square_in_bounds(c, adj)) continue;
+				noise = c->noise.grids[adj.y][adj.x];
+				if (!loc_eq(adj, origin) &&
+						(square_isnoflow(c, adj) || noise == 0))
+					continue;
+				if (quietest < 0 || noise < quietest) {
+					quietest = noise;
+				}
+			}
+			if (quietest < 0) continue;
+
+			c->noise.grids[grid.y][grid.x] = quietest + increment;
+			q_push_int(flow->queue, grid_to_i(grid, c->width));
+			spread_noise(c);
+		}
+		flow->opened_num = 0;
+		return;
+	}
+
+	/* Set all the grids to silence */
+	memset(&c->noise.grids[0][0], 0,
+		c->height * c->width * sizeof(c->noise.grids[0][0]));
+
+	/* Spread noise out from the origin */
+	flow->origin = origin;
+	flow->increment = increment;
+	flow->opened_num = 0;
+	q_push_int(flow->queue, grid_to_i(origin, c->width));
+	spread_noise(c);
+}
+
+/**
+ * Record that a grid has started (opened is true) or stopped carrying noise,
+ * so the next cave_update_noise() can account for it.  Noise can only get
+ * quieter when a grid opens, which can be patched up locally; when one closes
+ * the map is rebuilt.
+ */
+void cave_note_flow_change(struct chunk *c, struct loc grid, bool opened)
+{
+	struct noise_flow *flow = &c->noise_flow;
+
+	if (!flow->increment) return;
+	if (opened && flow->opened_num < NOISE_OPENED_MAX) {
+		flow->opened[flow->opened_num++] = grid;
+	} else {
+		flow->increment = 0;
+	}
+}
@@ -960,7 +960,12 @@ bool square_allows_summon(struct chunk *c, struct loc grid)
  * Below are various square-specific functions which are not predicates
  */
 
-const struct square *square(struct chunk *c, struct loc grid)
+/**
+ * Return the square at a grid.  The info flags may be changed in place through
+ * the result; feat, mon, obj and trap should be changed with the
+ * square_set_*() functions so that the bookkeeping stays consistent.
+ */
+struct square *square(struct chunk *c, struct loc grid)
 {
 	assert(square_in_bounds(c, grid));
 	return &c->squares[grid.y][grid.x];
@@ -978,6 +983,18 @@ int square_light(struct chunk *c, struct loc grid)
 	return square(c, grid)->light;
 }
 
+/**
+ * Get the age of the player's scent at a grid, or 0 if there is none.
+ */
+int square_scent(struct chunk *c, struct loc grid)
+{
+	uint16_t stamp;
+
+	assert(square_in_bounds(c, grid));
+	stamp = c->scent.grids[grid.y][grid.x];
+	return stamp ? (uint16_t) (c->scent_clock - stamp) : 0;
+}
+
 /**
  * Get a monster on the current level by its position.
  */
@@ -1247,6 +1264,11 @@ void square_set_feat(struct chunk *c, struct loc grid, int feat)
 	/* Make the change */
 	c->squares[grid.y][grid.x].feat = feat;
 
+	/* Let the noise map know if sound can now pass, or not */
+	if (feat_is_no_flow(current_feat) != feat_is_no_flow(feat)) {
+		cave_note_flow_change(c, grid, !feat_is_no_flow(feat));
+	}
+
 	/* Light bright terrain */
 	if (feat_is_bright(feat)) {
 		sqinfo_on(square(c, grid)->info, SQUARE_GLOW);
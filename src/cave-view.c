@@ -430,14 +430,16 @@ bool los(struct chunk *c, struct loc grid1, struct loc grid2)
 
 
 /**
- * Mark the currently seen grids, then wipe in preparation for recalculating
+ * Mark the currently seen grids, then wipe in preparation for recalculating.
+ * Only the area update_view() last scanned can hold view flags, so only that
+ * area is visited.
  */
 static void mark_wasseen(struct chunk *c)
 {
 	int x, y;
 	/* Save the old "view" grids for later */
-	for (y = 0; y < c->height; y++) {
-		for (x = 0; x < c->width; x++) {
+	for (y = c->view_tl.y; y <= c->view_br.y; y++) {
+		for (x = c->view_tl.x; x <= c->view_br.x; x++) {
 			struct loc grid = loc(x, y);
 			if (square_isseen(c, grid))
 				sqinfo_on(square(c, grid)->info, SQUARE_WASSEEN);
@@ -601,6 +603,16 @@ static bool glow_can_light_wall(struct chunk *c, struct player *p,
 	return false;
 }
 
+/**
+ * Help calc_lighting() and add_light():  check whether a grid is inside the
+ * box, given by its top left and bottom right corners, being lit.
+ */
+static bool grid_in_box(struct loc grid, struct loc tl, struct loc br)
+{
+	return grid.x >= tl.x && grid.x <= br.x && grid.y >= tl.y
+		&& grid.y <= br.y;
+}
+
 /**
  * Help calc_lighting():  add in the effect of a light source.
  * \param c Is the chunk to use.
@@ -608,12 +620,14 @@ static bool glow_can_light_wall(struct chunk *c, struct player *p,
  * \param sgrid Is the location of the light source.
  * \param radius Is the radius, in grids, of the light source.
  * \param inten Is the intensity of the light source.
+ * \param tl Is the top left corner of the box being lit.
+ * \param br Is the bottom right corner of the box being lit.
  * This is a brute force approach.  Some computation probably could be saved by
  * propagating the light out from the source and terminating paths when they
  * reach a wall.
  */
 static void add_light(struct chunk *c, struct player *p, struct loc sgrid,
-		int radius, int inten)
+		int radius, int inten, struct loc tl, struct loc br)
 {
 	int y;
 
@@ -623,7 +637,7 @@ static void add_light(struct chunk *c, struct player *p, struct loc sgrid,
 		for (x = -radius; x <= radius; x++) {
 			struct loc grid = loc_sum(sgrid, loc(x, y));
 			int dist = distance(sgrid, grid);
-			if (!square_in_bounds(c, grid)) continue;
+			if (!grid_in_box(grid, tl, br)) continue;
 			if (dist > radius) continue;
 			/* Don't propagate the light through walls. */
 			if (!los(c, sgrid, grid)) continue;
@@ -648,17 +662,24 @@ static void add_light(struct chunk *c, struct player *p, struct loc sgrid,
 }
 
 /**
- * Calculate light level for every grid in view - stolen from Sil
+ * Calculate light level for every grid in the box given by tl and br - stolen
+ * from Sil
+ *
+ * Light levels are only read for the player's grid and for grids in view, so
+ * update_view() passes the box that can be in view and the levels elsewhere
+ * are left as they were.  Light sources outside the box still contribute to
+ * the grids inside it.
  */
-static void calc_lighting(struct chunk *c, struct player *p)
+static void calc_lighting(struct chunk *c, struct player *p, struct loc tl,
+		struct loc br)
 {
 	int dir, k, x, y;
 	int light = p->state.cur_light, radius = ABS(light) - 1;
 	int old_light = square_light(c, p->grid);
 
 	/* Starting values based on permanent light */
-	for (y = 0; y < c->height; y++) {
-		for (x = 0; x < c->width; x++) {
+	for (y = tl.y; y <= br.y; y++) {
+		for (x = tl.x; x <= br.x; x++) {
 			struct loc grid = loc(x, y);
 
 			if (square_isglow(c, grid) &&
@@ -668,30 +689,38 @@ static void calc_lighting(struct chunk *c, struct player *p)
 			} else {
 				c->squares[y][x].light = 0;
 			}
+		}
+	}
 
-			/* Squares with bright terrain have intensity 2 */
-			if (square_isbright(c, grid)) {
+	/* Squares with bright terrain have intensity 2, and light their
+	 * neighbours, so look one grid beyond the box for them */
+	for (y = MAX(tl.y - 1, 0); y <= MIN(br.y + 1, c->height - 1); y++) {
+		for (x = MAX(tl.x - 1, 0); x <= MIN(br.x + 1, c->width - 1); x++) {
+			struct loc grid = loc(x, y);
+
+			if (!square_isbright(c, grid)) continue;
+			if (grid_in_box(grid, tl, br)) {
 				c->squares[y][x].light += 2;
-				for (dir = 0; dir < 8; dir++) {
-					struct loc adj_grid = loc_sum(grid, ddgrid_ddd[dir]);
-					if (!square_in_bounds(c, adj_grid)) continue;
-					/*
-					 * Only brighten a wall if the player
-					 * is in position to view the face
-					 * that's lit up.
-					 */
-					if (!square_allowslos(c, adj_grid) &&
-							!source_can_light_wall(
-							c, p, grid, adj_grid))
-							continue;
-					c->squares[adj_grid.y][adj_grid.x].light += 1;
-				}
+			}
+			for (dir = 0; dir < 8; dir++) {
+				struct loc adj_grid = loc_sum(grid, ddgrid_ddd[dir]);
+				if (!grid_in_box(adj_grid, tl, br)) continue;
+				/*
+				 * Only brighten a wall if the player
+				 * is in position to view the face
+				 * that's lit up.
+				 */
+				if (!square_allowslos(c, adj_grid) &&
+						!source_can_light_wall(
+						c, p, grid, adj_grid))
+						continue;
+				c->squares[adj_grid.y][adj_grid.x].light += 1;
 			}
 		}
 	}
 
 	/* Light around the player */
-	add_light(c, p, p->grid, radius, light);
+	add_light(c, p, p->grid, radius, light, tl, br);
 
 	/* Scan monster list and add monster light or darkness */
 	for (k = 1; k < cave_monster_max(c); k++) {
@@ -715,7 +744,7 @@ static void calc_lighting(struct chunk *c, struct player *p)
 		if (distance(p->grid, mon->grid) - radius > z_info->max_sight)
 			continue;
 
-		add_light(c, p, mon->grid, radius, light);
+		add_light(c, p, mon->grid, radius, light, tl, br);
 	}
 
 	/* Update light level indicator */
@@ -867,16 +896,27 @@ static void update_one(struct chunk *c, struct loc grid, struct player *p)
 
 /**
  * Update the player's current view
+ *
+ * No grid further than z_info->max_sight from the player can be in view, so
+ * only the box of that radius around the player is checked for view, and the
+ * flags are only refreshed there and in the box from the previous call.  A
+ * new chunk starts with the whole level as its previous box, so any stale
+ * flags it was created with are cleared the first time through.
  */
 void update_view(struct chunk *c, struct player *p)
 {
 	int x, y;
+	int r = z_info->max_sight;
+	struct loc old_tl = c->view_tl, old_br = c->view_br;
+	struct loc tl = loc(MAX(p->grid.x - r, 0), MAX(p->grid.y - r, 0));
+	struct loc br = loc(MIN(p->grid.x + r, c->width - 1),
+		MIN(p->grid.y + r, c->height - 1));
 
 	/* Record the current view */
 	mark_wasseen(c);
 
 	/* Calculate light levels */
-	calc_lighting(c, p);
+	calc_lighting(c, p, tl, br);
 
 	/* Assume we can view the player grid */
 	sqinfo_on(square(c, p->grid)->info, SQUARE_VIEW);
@@ -897,14 +937,23 @@ void update_view(struct chunk *c, struct player *p)
 	}
 
 	/* Squares we have LOS to get marked as in the view, and perhaps seen */
-	for (y = 0; y < c->height; y++)
-		for (x = 0; x < c->width; x++)
+	for (y = tl.y; y <= br.y; y++)
+		for (x = tl.x; x <= br.x; x++)
 			update_view_one(c, loc(x, y), p);
 
-	/* Update each grid */
-	for (y = 0; y < c->height; y++)
-		for (x = 0; x < c->width; x++)
+	/* Update each grid that is or was in range, visiting each only once */
+	for (y = tl.y; y <= br.y; y++)
+		for (x = tl.x; x <= br.x; x++)
 			update_one(c, loc(x, y), p);
+	for (y = old_tl.y; y <= old_br.y; y++) {
+		for (x = old_tl.x; x <= old_br.x; x++) {
+			if (grid_in_box(loc(x, y), tl, br)) continue;
+			update_one(c, loc(x, y), p);
+		}
+	}
+
+	c->view_tl = tl;
+	c->view_br = br;
 }
 
 
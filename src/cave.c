@@ -32,6 +32,8 @@
 #include "object.h"
 #include "player-timed.h"
 #include "trap.h"
+#include "z-queue.h"
+#include "z-strmap.h"
 
 struct feature *f_info;
 struct chunk *cave = NULL;
@@ -279,6 +281,22 @@ struct loc next_grid(struct loc grid, int dir)
 	return loc(grid.x + ddgrid[dir].x, grid.y + ddgrid[dir].y);
 }
 
+/**
+ * Index of terrain feature names, built when first needed
+ */
+static struct strmap *feat_names;
+static const struct feature *feat_names_info;
+
+/**
+ * Forget the index of terrain feature names
+ */
+void reset_feat_lookups(void)
+{
+	strmap_free(feat_names);
+	feat_names = NULL;
+	feat_names_info = NULL;
+}
+
 /**
  * Find a terrain feature index by its printable name.
  */
@@ -286,6 +304,23 @@ int lookup_feat(const char *name)
 {
 	int i;
 
+	/* Try the index */
+	if (f_info) {
+		if (!feat_names || feat_names_info != f_info) {
+			reset_feat_lookups();
+			feat_names = strmap_new(false);
+			feat_names_info = f_info;
+			for (i = 0; i < FEAT_MAX; i++) {
+				if (f_info[i].name)
+					strmap_add(feat_names, f_info[i].name,
+						(void *)(uintptr_t)(i + 1));
+			}
+		}
+		i = (int)(uintptr_t)strmap_get(feat_names, name);
+		if (i && f_info[i - 1].name && streq(name, f_info[i - 1].name))
+			return i - 1;
+	}
+
 	/* Look for it */
 	for (i = 0; i < FEAT_MAX; i++) {
 		struct feature *feat = &f_info[i];
@@ -338,28 +373,51 @@ const char *get_feat_code_name(int idx)
 	return (idx < 0 || idx >= FEAT_MAX) ? NULL : feat_code_list[idx];
 }
 
+/**
+ * Allocate a zeroed two-dimensional grid of elements as one block.
+ *
+ * The block starts with a table of height row pointers, followed by the
+ * height * width elements themselves in row-major order, so the result can
+ * be indexed as grid[y][x] and freed with a single mem_free().
+ */
+static void *cave_grid_alloc(int height, int width, size_t elt_size)
+{
+	void **rows = mem_zalloc(height * sizeof(*rows)
+		+ (size_t) height * width * elt_size);
+	char *elts = (char *) (rows + height);
+	int y;
+
+	for (y = 0; y < height; y++) {
+		rows[y] = elts + (size_t) y * width * elt_size;
+	}
+
+	return rows;
+}
+
 /**
  * Allocate a new chunk of the world
  */
 struct chunk *cave_new(int height, int width) {
-	int y, x;
-
 	struct chunk *c = mem_zalloc(sizeof *c);
 	c->height = height;
 	c->width = width;
 	c->feat_count = mem_zalloc((FEAT_MAX + 1) * sizeof(int));
 
-	c->squares = mem_zalloc(c->height * sizeof(struct square*));
-	c->noise.grids = mem_zalloc(c->height * sizeof(uint16_t*));
-	c->scent.grids = mem_zalloc(c->height * sizeof(uint16_t*));
-	for (y = 0; y < c->height; y++) {
-		c->squares[y] = mem_zalloc(c->width * sizeof(struct square));
-		for (x = 0; x < c->width; x++) {
-			c->squares[y][x].info = mem_zalloc(SQUARE_SIZE * sizeof(bitflag));
-		}
-		c->noise.grids[y] = mem_zalloc(c->width * sizeof(uint16_t));
-		c->scent.grids[y] = mem_zalloc(c->width * sizeof(uint16_t));
-	}
+	c->squares = cave_grid_alloc(height, width, sizeof(struct square));
+	c->noise.grids = cave_grid_alloc(height, width, sizeof(uint16_t));
+	c->scent.grids = cave_grid_alloc(height, width, sizeof(uint16_t));
+
+	/* Scent is laid with ages up to 2; keep the stamps for it nonzero */
+	c->scent_clock = 3;
+
+	/* Nothing is known about the view flags yet, so check everything */
+	c->view_tl = loc(0, 0);
+	c->view_br = loc(width - 1, height - 1);
+
+	/* Nothing is marked for redraw yet */
+	c->redraw = mem_zalloc(((height * width + 31) / 32) * sizeof(uint32_t));
+	c->redraw_tl = loc(width, height);
+	c->redraw_br = loc(0, 0);
 
 	c->objects = mem_zalloc(OBJECT_LIST_SIZE * sizeof(struct object*));
 	c->obj_max = OBJECT_LIST_SIZE - 1;
@@ -407,23 +465,27 @@ void cave_free(struct chunk *c) {
 
 	for (y = 0; y < c->height; y++) {
 		for (x = 0; x < c->width; x++) {
-			mem_free(c->squares[y][x].info);
 			if (c->squares[y][x].trap)
 				square_free_trap(c, loc(x, y));
 			if (c->squares[y][x].obj)
 				object_pile_free(c, p_c, c->squares[y][x].obj);
 		}
-		mem_free(c->squares[y]);
-		mem_free(c->noise.grids[y]);
-		mem_free(c->scent.grids[y]);
 	}
 	mem_free(c->squares);
 	mem_free(c->noise.grids);
+	if (c->noise_flow.queue)
+		q_free(c->noise_flow.queue);
 	mem_free(c->scent.grids);
+	mem_free(c->redraw);
 
 	mem_free(c->feat_count);
 	mem_free(c->objects);
 	mem_free(c->monsters);
+	if (c->mon_schedule.buckets) {
+		for (i = 0; i < c->mon_schedule.num_buckets; i++)
+			mem_free(c->mon_schedule.buckets[i].midx);
+		mem_free(c->mon_schedule.buckets);
+	}
 	mem_free(c->monster_groups);
 	if (c->name)
 		string_free(c->name);
@@ -25,6 +25,8 @@
 struct player;
 struct monster;
 struct monster_group;
+struct chunk_pack;
+struct queue;
 
 extern const int16_t ddd[9];
 extern const int16_t ddx[10];
@@ -158,19 +160,72 @@ struct grid_data {
 	bool hallucinate;
 };
 
+/**
+ * A single grid of a chunk.  The info flags are held inline so that each
+ * square is self-contained and all of a chunk's squares can live in one
+ * contiguous block (see cave_new()).
+ */
 struct square {
 	uint8_t feat;
-	bitflag *info;
+	bitflag info[SQUARE_SIZE];
 	int light;
 	int16_t mon;
 	struct object *obj;
 	struct trap *trap;
 };
 
+/**
+ * Per-grid values such as noise or scent.  grids[y] are row pointers into a
+ * single contiguous, row-major block of height * width values.
+ */
 struct heatmap {
 	uint16_t **grids;
 };
 
+/**
+ * Maximum number of grids that can start carrying noise between two updates
+ * of the noise map before it is simply rebuilt
+ */
+#define NOISE_OPENED_MAX 8
+
+/**
+ * State kept between updates of a chunk's noise map, so the map only has to
+ * be rebuilt when the player moves or terrain stops carrying noise (see
+ * cave_update_noise())
+ */
+struct noise_flow {
+	struct loc origin;	/**< Grid the noise was last spread from */
+	int increment;		/**< Noise added per step, or 0 if no valid map */
+	struct queue *queue;	/**< Work queue, kept between updates */
+	struct loc opened[NOISE_OPENED_MAX];	/**< Grids which have started
+						 * carrying noise since then */
+	int opened_num;
+};
+
+/**
+ * Monsters due to act on one game turn, highest monster index first
+ */
+struct mon_bucket {
+	int16_t *midx;
+	int num;
+	int size;
+};
+
+/**
+ * Order in which a chunk's monsters are due to act (see process_monsters());
+ * buckets is NULL when the monsters' own energy and MFLAG_HANDLED are to be
+ * trusted instead, as for stored levels
+ */
+struct mon_schedule {
+	struct mon_bucket *buckets;	/**< Ring of buckets indexed by the
+					 * game turn */
+	int num_buckets;
+	bool stale;		/**< Monster indices have changed since the
+				 * buckets were filled */
+	int32_t sweep_turn;	/**< Turn of the last pass over all monsters */
+	int sweep_pos;		/**< Monster index that pass has got down to */
+};
+
 struct connector {
 	struct loc grid;
 	uint8_t feat;
@@ -194,11 +249,25 @@ struct chunk {
 	uint16_t feeling_squares; /* How many feeling squares the player has visited */
 	int *feat_count;
 
-	struct square **squares;
+	struct square **squares;	/**< Row pointers into one row-major block;
+					 * &squares[0][0] is the start of it */
 	struct heatmap noise;
-	struct heatmap scent;
+	struct noise_flow noise_flow;
+	struct heatmap scent;	/**< Value of scent_clock when scent was laid,
+				 * less its age then, or 0 for no scent */
+	uint16_t scent_clock;	/**< Goes up by one each time scent ages */
 	struct loc decoy;
 
+	struct loc view_tl;	/**< Top left of the area last scanned by
+				 * update_view() */
+	struct loc view_br;	/**< Bottom right of that area */
+
+	uint32_t *redraw;	/**< A bit for each grid the UI is to redraw,
+				 * row after row; see square_light_spot() */
+	struct loc redraw_tl;	/**< Top left of the grids marked for redraw */
+	struct loc redraw_br;	/**< Bottom right of them; left of redraw_tl
+				 * if there are none */
+
 	struct object **objects;
 	uint16_t obj_max;
 
@@ -207,10 +276,14 @@ struct chunk {
 	uint16_t mon_cnt;
 	int mon_current;
 	int num_repro;
+	struct mon_schedule mon_schedule;
 
 	struct monster_group **monster_groups;
 
 	struct connector *join;
+
+	struct chunk_pack *pack;	/**< The rest of the chunk, packed away
+					 * while it is stored and not in use */
 };
 
 /*** Feature Indexes (see "lib/gamedata/terrain.txt") ***/
@@ -237,13 +310,17 @@ bool no_light(const struct player *p);
 void map_info(struct loc grid, struct grid_data *g);
 void square_note_spot(struct chunk *c, struct loc grid);
 void square_light_spot(struct chunk *c, struct loc grid);
+void square_mark_redraw(struct chunk *c, struct loc grid);
+bool square_isredraw(struct chunk *c, struct loc grid);
+bool cave_redraw_pending(struct chunk *c);
+void cave_clear_redraw(struct chunk *c);
 void light_room(struct loc grid, bool light);
 void wiz_light(struct chunk *c, struct player *p, bool full);
 void wiz_dark(struct chunk *c, struct player *p, bool full);
 void cave_illuminate(struct chunk *c, bool daytime);
 void expose_to_sun(struct chunk *c, struct loc grid, bool daytime);
-void cave_update_flow(struct chunk *c);
-void cave_forget_flow(struct chunk *c);
+void cave_update_noise(struct chunk *c, struct loc origin, int increment);
+void cave_note_flow_change(struct chunk *c, struct loc grid, bool opened);
 
 /* cave-square.c */
 /**
@@ -363,9 +440,10 @@ bool square_suits_stairs_ok(struct chunk *c, struct loc grid);
 bool square_allows_summon(struct chunk *c, struct loc grid);
 
 
-const struct square *square(struct chunk *c, struct loc grid);
+struct square *square(struct chunk *c, struct loc grid);
 struct feature *square_feat(struct chunk *c, struct loc grid);
 int square_light(struct chunk *c, struct loc grid);
+int square_scent(struct chunk *c, struct loc grid);
 struct monster *square_monster(struct chunk *c, struct loc grid);
 struct object *square_object(struct chunk *c, struct loc grid);
 struct trap *square_trap(struct chunk *c, struct loc grid);
@@ -427,6 +505,7 @@ void square_unmark(struct chunk *c, struct loc grid);
 /* cave.c */
 int motion_dir(struct loc source, struct loc target);
 struct loc next_grid(struct loc grid, int dir);
+void reset_feat_lookups(void);
 int lookup_feat(const char *name);
 int lookup_feat_code(const char *code);
 const char *get_feat_code_name(int idx);
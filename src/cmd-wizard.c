@@ -1460,7 +1460,7 @@ static void wiz_hack_map_peek_noise(struct chunk *c, void *closure,
 static void wiz_hack_map_peek_scent(struct chunk *c, void *closure,
 	struct loc grid, bool *show, uint8_t *color)
 {
-	if (c->scent.grids[grid.y][grid.x] == *((int*)closure)) {
+	if (square_scent(c, grid) == *((int*)closure)) {
 		*show = true;
 		*color = COLOUR_YELLOW;
 	} else {
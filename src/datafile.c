@@ -20,6 +20,7 @@
  */
 
 #include "angband.h"
+#include "buildid.h"
 #include "datafile.h"
 #include "game-world.h"
 #include "init.h"
@@ -86,6 +87,145 @@ errr parse_file_quit_not_found(struct parser *p, const char *filename) {
 	return parse_err;
 }
 
+/**
+ * ------------------------------------------------------------------------
+ * Cache of parsed data files
+ *
+ * After a data file is parsed, the values parsed from each of its lines are
+ * saved in the cache directory under the user directory.  The next time the
+ * same file is parsed with the same hooks, the saved values are given to the
+ * hooks again without reading and splitting up the text.
+ *
+ * A cache file has a header:
+ *     4 bytes      magic, "AGDC"
+ *     4 bytes      format version
+ *     8 bytes      key, a hash of the text file, the parser's hooks and the
+ *                  game version
+ *     4 bytes      length of the recording that follows
+ * All numbers are stored least significant byte first.
+ * ------------------------------------------------------------------------ */
+#define PARSE_CACHE_MAGIC		"AGDC"
+#define PARSE_CACHE_VERSION		2
+#define PARSE_CACHE_HEADER_SIZE	20
+
+static uint64_t hash_bytes(uint64_t hash, const uint8_t *b, size_t n)
+{
+	size_t i;
+
+	for (i = 0; i < n; i++)
+		hash = (hash ^ b[i]) * 0x100000001b3ULL;
+	return hash;
+}
+
+/**
+ * Work out the key for the cached copy of the open text file fh.
+ */
+static uint64_t parse_cache_key(struct parser *p, ang_file *fh)
+{
+	uint64_t hash = 0xcbf29ce484222325ULL, sig = parser_signature(p);
+	uint8_t buf[4096];
+	int i, n;
+
+	while ((n = file_read(fh, (char *)buf, sizeof(buf))) > 0)
+		hash = hash_bytes(hash, buf, n);
+	for (i = 0; i < 8; i++)
+		buf[i] = (sig >> (8 * i)) & 0xFF;
+	hash = hash_bytes(hash, buf, 8);
+	return hash_bytes(hash, (const uint8_t *)buildver, strlen(buildver));
+}
+
+static void parse_cache_path(char *buf, size_t len, const char *filename)
+{
+	char dir[1024];
+
+	path_build(dir, sizeof(dir), ANGBAND_DIR_USER, "cache");
+	path_build(buf, len, dir, format("%s.dat", filename));
+}
+
+static uint32_t get_u32(const uint8_t *b)
+{
+	return (uint32_t)b[0] | ((uint32_t)b[1] << 8)
+		| ((uint32_t)b[2] << 16) | ((uint32_t)b[3] << 24);
+}
+
+static void put_u32(uint8_t *b, uint32_t v)
+{
+	b[0] = v & 0xFF;
+	b[1] = (v >> 8) & 0xFF;
+	b[2] = (v >> 16) & 0xFF;
+	b[3] = (v >> 24) & 0xFF;
+}
+
+/**
+ * Read the recording in the cache file for filename if it has the given
+ * key, returning it and putting its length in len; otherwise return NULL.
+ */
+static uint8_t *read_parse_cache(const char *filename, uint64_t key,
+		size_t *len)
+{
+	char path[1024];
+	uint8_t head[PARSE_CACHE_HEADER_SIZE], *buf = NULL;
+	ang_file *f;
+
+	parse_cache_path(path, sizeof(path), filename);
+	f = file_open(path, MODE_READ, FTYPE_RAW);
+	if (!f) return NULL;
+
+	if (file_read(f, (char *)head, sizeof(head)) == sizeof(head)
+			&& !memcmp(head, PARSE_CACHE_MAGIC, 4)
+			&& get_u32(head + 4) == PARSE_CACHE_VERSION
+			&& get_u32(head + 8) == (uint32_t)key
+			&& get_u32(head + 12) == (uint32_t)(key >> 32)) {
+		*len = get_u32(head + 16);
+		buf = mem_alloc(MAX(*len, 1));
+		if (file_read(f, (char *)buf, *len) != (int)*len) {
+			mem_free(buf);
+			buf = NULL;
+		}
+	}
+	file_close(f);
+	return buf;
+}
+
+/**
+ * Save what the parser recorded from the text file as the cache file for
+ * filename.  Failure is not an error; the text is just parsed again next
+ * time.
+ */
+static void write_parse_cache(struct parser *p, const char *filename,
+		uint64_t key)
+{
+	char dir[1024], path[1024], new_path[1024];
+	uint8_t head[PARSE_CACHE_HEADER_SIZE];
+	const uint8_t *rec;
+	size_t len;
+	ang_file *f;
+	bool ok;
+
+	rec = parser_recording(p, &len);
+	path_build(dir, sizeof(dir), ANGBAND_DIR_USER, "cache");
+	if (!dir_create(dir)) return;
+	parse_cache_path(path, sizeof(path), filename);
+	strnfmt(new_path, sizeof(new_path), "%s.new", path);
+
+	memcpy(head, PARSE_CACHE_MAGIC, 4);
+	put_u32(head + 4, PARSE_CACHE_VERSION);
+	put_u32(head + 8, (uint32_t)key);
+	put_u32(head + 12, (uint32_t)(key >> 32));
+	put_u32(head + 16, (uint32_t)len);
+
+	f = file_open(new_path, MODE_WRITE, FTYPE_RAW);
+	if (!f) return;
+	ok = file_write(f, (const char *)head, sizeof(head))
+		&& (!len || file_write(f, (const char *)rec, len));
+	if (!file_close(f)) ok = false;
+	if (ok) {
+		if (file_exists(path)) file_delete(path);
+		ok = file_move(new_path, path);
+	}
+	if (!ok) file_delete(new_path);
+}
+
 /**
  * The basic file parsing function.
  */
@@ -93,6 +233,9 @@ errr parse_file(struct parser *p, const char *filename) {
 	char path[1024];
 	char buf[1024];
 	ang_file *fh;
+	uint8_t *cached;
+	uint64_t key;
+	size_t len;
 	errr r = 0;
 
 	/* The player can put a customised file in the user directory */
@@ -111,13 +254,32 @@ errr parse_file(struct parser *p, const char *filename) {
 	if (!fh)
 		return PARSE_ERROR_NO_FILE_FOUND;
 
+	/* Use the cached values if the file hasn't changed */
+	key = parse_cache_key(p, fh);
+	file_close(fh);
+	cached = read_parse_cache(filename, key, &len);
+	if (cached && parser_replay_check(p, cached, len)) {
+		r = parser_replay(p, cached, len);
+		mem_free(cached);
+		return r;
+	}
+	mem_free(cached);
+
+	fh = file_open(path, MODE_READ, FTYPE_TEXT);
+	if (!fh)
+		return PARSE_ERROR_NO_FILE_FOUND;
+
 	/* Parse it */
+	parser_record(p, true);
 	while (file_getl(fh, buf, sizeof(buf))) {
 		r = parser_parse(p, buf);
 		if (r)
 			break;
 	}
+	parser_record(p, false);
 	file_close(fh);
+
+	if (!r) write_parse_cache(p, filename, key);
 	return r;
 }
 
@@ -126,32 +288,188 @@ void cleanup_parser(struct file_parser *fp)
 	fp->cleanup();
 }
 
-int lookup_flag(const char **flag_table, const char *flag_name) {
-	int i = FLAG_START;
+/**
+ * Hash tables over the NULL-terminated name lists, such as the flag names made
+ * from the list-*.h files, which lookup_flag() and code_index_in_array()
+ * search.  The lists are static, so each gets a table the first time it is
+ * searched, found again by the address of the list.  A table is built so that
+ * no name is more than NAME_TABLE_PROBES slots from where it hashes, which
+ * bounds the work for any lookup.
+ */
+#define NAME_TABLE_PROBES 4
+
+struct name_table {
+	const char **names;
+	int start;
+	uint32_t seed;
+	uint32_t mask;
+	uint16_t *slots;	/* index + 1 of the name, or 0 */
+};
 
-	while (flag_table[i] && !streq(flag_table[i], flag_name))
-		i++;
+static struct name_table *name_tables;
+static uint32_t name_tables_mask;
+static uint32_t name_tables_count;
 
-	/* End of table reached without match */
-	if (!flag_table[i]) i = FLAG_END;
+static uint32_t hash_name(const char *name, uint32_t seed)
+{
+	uint32_t h = 2166136261u ^ (seed * 0x9E3779B9u);
 
-	return i;
+	while (*name) {
+		h ^= (unsigned char)*name++;
+		h *= 16777619u;
+	}
+	return h ^ (h >> 15);
 }
 
-int code_index_in_array(const char *code_name[], const char *code)
+/**
+ * Place names[start] onwards in t; false if some name would be too far from
+ * its slot.
+ */
+static bool fill_name_table(struct name_table *t)
 {
-	int i = 0;
+	int i;
 
-	while (code_name[i]) {
-		if (streq(code_name[i], code)) {
-			return i;
+	memset(t->slots, 0, (t->mask + 1) * sizeof(*t->slots));
+	for (i = t->start; t->names[i]; i++) {
+		uint32_t h = hash_name(t->names[i], t->seed);
+		int probe;
+
+		for (probe = 0; probe < NAME_TABLE_PROBES; probe++) {
+			uint16_t *slot = &t->slots[(h + probe) & t->mask];
+
+			if (!*slot) {
+				*slot = i + 1;
+				break;
+			}
+
+			/* Later copies of a name are never found */
+			if (streq(t->names[*slot - 1], t->names[i])) break;
 		}
-		i++;
+		if (probe == NAME_TABLE_PROBES) return false;
+	}
+	return true;
+}
+
+static void build_name_table(struct name_table *t)
+{
+	uint32_t size = 8;
+	int n = 0;
+
+	while (t->names[t->start + n]) n++;
+	assert(t->start + n < 65535);
+	while (size < 2 * (uint32_t)n) size *= 2;
+
+	/* Try a few seeds at each size before making the table bigger */
+	while (true) {
+		t->mask = size - 1;
+		t->slots = mem_alloc(size * sizeof(*t->slots));
+		for (t->seed = 0; t->seed < 8; t->seed++) {
+			if (fill_name_table(t)) return;
+		}
+		mem_free(t->slots);
+		size *= 2;
+	}
+}
+
+static uint32_t hash_list(const char **names, int start)
+{
+	uintptr_t h = (uintptr_t)names ^ (uintptr_t)start;
+
+	return (uint32_t)((h >> 3) * 0x9E3779B9u);
+}
+
+/**
+ * Return the table for names[start] onwards, building it if need be
+ */
+static struct name_table *get_name_table(const char **names, int start)
+{
+	struct name_table *t;
+	uint32_t i;
+
+	if (name_tables) {
+		for (i = hash_list(names, start); ; i++) {
+			t = &name_tables[i & name_tables_mask];
+			if (!t->names) break;
+			if (t->names == names && t->start == start) return t;
+		}
+	}
+
+	/* Keep the tables at most half full */
+	if (2 * (name_tables_count + 1) > name_tables_mask + 1) {
+		struct name_table *old = name_tables;
+		uint32_t old_size = old ? name_tables_mask + 1 : 0;
+
+		name_tables_mask = old ? 2 * name_tables_mask + 1 : 31;
+		name_tables = mem_zalloc((name_tables_mask + 1)
+			* sizeof(*name_tables));
+		for (i = 0; i < old_size; i++) {
+			uint32_t j;
+
+			if (!old[i].names) continue;
+			j = hash_list(old[i].names, old[i].start);
+			while (name_tables[j & name_tables_mask].names) j++;
+			name_tables[j & name_tables_mask] = old[i];
+		}
+		mem_free(old);
 	}
 
+	for (i = hash_list(names, start); ; i++) {
+		t = &name_tables[i & name_tables_mask];
+		if (!t->names) break;
+	}
+	t->names = names;
+	t->start = start;
+	build_name_table(t);
+	name_tables_count++;
+	return t;
+}
+
+/**
+ * Return the index of the first copy of name in names[start] onwards, or -1
+ */
+static int find_name(const char **names, int start, const char *name)
+{
+	struct name_table *t = get_name_table(names, start);
+	uint32_t h = hash_name(name, t->seed);
+	int probe;
+
+	for (probe = 0; probe < NAME_TABLE_PROBES; probe++) {
+		uint16_t slot = t->slots[(h + probe) & t->mask];
+
+		if (!slot) break;
+		if (streq(names[slot - 1], name)) return slot - 1;
+	}
 	return -1;
 }
 
+/**
+ * Free the tables made for lookup_flag() and code_index_in_array()
+ */
+void cleanup_name_tables(void)
+{
+	uint32_t i;
+
+	if (!name_tables) return;
+	for (i = 0; i <= name_tables_mask; i++)
+		mem_free(name_tables[i].slots);
+	mem_free(name_tables);
+	name_tables = NULL;
+	name_tables_mask = 0;
+	name_tables_count = 0;
+}
+
+int lookup_flag(const char **flag_table, const char *flag_name) {
+	int i = find_name(flag_table, FLAG_START, flag_name);
+
+	/* End of table reached without match */
+	return (i < 0) ? FLAG_END : i;
+}
+
+int code_index_in_array(const char *code_name[], const char *code)
+{
+	return find_name(code_name, 0, code);
+}
+
 /**
  * Gets a name and argument for a value expression of the form NAME[arg]
  * \param value_name points to the expression to parse; on return it will be
@@ -36,6 +36,7 @@ errr run_parser(struct file_parser *fp);
 errr parse_file_quit_not_found(struct parser *p, const char *filename);
 errr parse_file(struct parser *p, const char *filename);
 void cleanup_parser(struct file_parser *fp);
+void cleanup_name_tables(void);
 int lookup_flag(const char **flag_table, const char *flag_name);
 int code_index_in_array(const char *code_name[], const char *code);
 errr grab_rand_value(random_value *value, const char **value_type,
@@ -383,64 +383,15 @@ static void decrease_timeouts(void)
  * values, thereby homing in on the player even though twisty tunnels and
  * mazes.  Monsters have a hearing value, which is the largest sound value
  * they can detect.
+ *
+ * The map is kept between turns and only redone as far as needed when the
+ * player moves or the terrain changes; see cave_update_noise().
  */
 static void make_noise(struct player *p)
 {
-	struct loc next = p->grid;
-	int y, x, d;
-	int noise = 0;
 	int noise_increment = p->timed[TMD_COVERTRACKS] ? 4 : 1;
-    struct queue *queue = q_new(cave->height * cave->width);
-
-	/* Set all the grids to silence */
-	for (y = 1; y < cave->height - 1; y++) {
-		for (x = 1; x < cave->width - 1; x++) {
-			cave->noise.grids[y][x] = 0;
-		}
-	}
-
-	/* Player makes noise */
-	cave->noise.grids[next.y][next.x] = noise;
-	q_push_int(queue, grid_to_i(next, cave->width));
-	noise += noise_increment;
-
-	/* Propagate noise */
-	while (q_len(queue) > 0) {
-		/* Get the next grid */
-		i_to_grid(q_pop_int(queue), cave->width, &next);
-
-		/* If we've reached the current noise level, put it back and step */
-		if (cave->noise.grids[next.y][next.x] == noise) {
-			q_push_int(queue, grid_to_i(next, cave->width));
-			noise += noise_increment;
-			continue;
-		}
-
-		/* Assign noise to the children and enqueue them */
-		for (d = 0; d < 8; d++)	{
-			/* Child location */
-			struct loc grid = loc_sum(next, ddgrid_ddd[d]);
-
-			if (!square_in_bounds(cave, grid)) continue;
-
-			/* Ignore features that don't transmit sound */
-			if (square_isnoflow(cave, grid)) continue;
-
-			/* Skip grids that already have noise */
-			if (cave->noise.grids[grid.y][grid.x] != 0) continue;
 
-			/* Skip the player grid */
-			if (loc_eq(p->grid, grid)) continue;
-
-			/* Save the noise */
-			cave->noise.grids[grid.y][grid.x] = noise;
-
-			/* Enqueue that entry */
-			q_push_int(queue, grid_to_i(grid, cave->width));
-		}
-	}
-
-	q_free(queue);
+	cave_update_noise(cave, p->grid, noise_increment);
 }
 
 /**
@@ -456,6 +407,11 @@ static void make_noise(struct player *p)
  * value which indicates the oldest scent they can detect.  Grids where the
  * player has never been will have scent 0.  The player's grid will also have
  * scent 0, but this is OK as no monster will ever be smelling it.
+ *
+ * Rather than the age itself, each grid holds the value cave->scent_clock had
+ * when the scent was laid, less the age it was laid with; see square_scent().
+ * Ageing all the scent on the level is then just a matter of advancing the
+ * clock.
  */
 static void update_scent(void)
 {
@@ -469,13 +425,24 @@ static void update_scent(void)
 	};
 
 	/* Update scent for all grids */
-	for (y = 1; y < cave->height - 1; y++) {
-		for (x = 1; x < cave->width - 1; x++) {
-			if (cave->scent.grids[y][x] > 0) {
-				cave->scent.grids[y][x]++;
+	if (cave->scent_clock == UINT16_MAX) {
+		/*
+		 * Out of clock values, so move it back, keeping the ages of
+		 * any scent young enough to still matter
+		 */
+		uint16_t clock = UINT16_MAX / 2;
+
+		for (y = 0; y < cave->height; y++) {
+			for (x = 0; x < cave->width; x++) {
+				int age = square_scent(cave, loc(x, y));
+
+				cave->scent.grids[y][x] =
+					(age && age < clock) ? clock - age : 0;
 			}
 		}
+		cave->scent_clock = clock;
 	}
+	cave->scent_clock++;
 
 	/* Scentless player */
 	if (player->timed[TMD_COVERTRACKS]) return;
@@ -510,7 +477,7 @@ static void update_scent(void)
 				}
 
 				/* Adjacent to a closer grid, so valid */
-				if (cave->scent.grids[adj.y][adj.x] == new_scent - 1) {
+				if (square_scent(cave, adj) == new_scent - 1) {
 					add_scent = true;
 				}
 			}
@@ -520,8 +487,9 @@ static void update_scent(void)
 				continue;
 			}
 
-			/* Mark the scent */
-			cave->scent.grids[scent.y][scent.x] = new_scent;
+			/* Mark the scent; fresh scent of age 0 is no scent */
+			cave->scent.grids[scent.y][scent.x] = new_scent ?
+				cave->scent_clock - new_scent : 0;
 		}
 	}
 }
@@ -1011,6 +979,9 @@ void on_new_level(void)
 
 		/* Cancel the health bar */
 		health_track(player->upkeep, NULL);
+
+		/* Pack away the stored levels, now nothing refers to them */
+		chunk_list_pack();
 	}
 
 	/* Disturb */
@@ -1067,6 +1038,9 @@ static void on_leave_level(void) {
 	/* Don't allow command repeat if moved away from item used. */
 	cmd_disable_repeat_floor_item();
 
+	/* Leave the monsters as they are now */
+	monsters_sync_energy(cave);
+
 	/* Any pending processing */
 	notice_stuff(player);
 	update_stuff(player);
@@ -21,6 +21,12 @@
  *
  * The copying routines are also useful for generating a level in pieces and
  * then copying those pieces into the actual level chunk.
+ *
+ * Stored chunks which aren't in play are packed into the form they take in
+ * a savefile, keeping out only what is needed to find them and to join
+ * stairs to them, and unpacked when they are found by name.  Packed chunks
+ * stay in memory up to z_info->level_store_kb kilobytes; beyond that the
+ * least recently used are moved out to a temporary file.
  */
 
 #include "angband.h"
@@ -30,13 +36,36 @@
 #include "init.h"
 #include "mon-group.h"
 #include "mon-make.h"
+#include "obj-pile.h"
 #include "obj-util.h"
+#include "player.h"
+#include "savefile.h"
 #include "trap.h"
+#include "z-strmap.h"
 
 #define CHUNK_LIST_INCR 10
 struct chunk **chunk_list;     /**< list of pointers to saved chunks */
 uint16_t chunk_list_max = 0;   /**< current max actual chunk index */
 
+/**
+ * A packed chunk, held in memory or in the spill file
+ */
+struct chunk_pack {
+	uint8_t *data;		/**< The packed bytes, or NULL if spilled */
+	uint32_t size;		/**< How many bytes there are */
+	long offset;		/**< Where they are in the spill file */
+	uint32_t used;		/**< chunk_clock when last packed or used */
+};
+
+static struct strmap *chunk_names;	/**< Chunks in chunk_list by name */
+static uint32_t chunk_clock;		/**< Ticks for each chunk packed */
+static size_t chunk_pack_bytes;		/**< Packed bytes held in memory */
+static ang_file *chunk_spill;		/**< File for packed chunks spilled */
+static long chunk_spill_size;		/**< Length of the spill file */
+static int chunk_spill_count;		/**< Packed chunks in the spill file */
+static uint8_t *chunk_scratch;		/**< Room for reading spilled chunks */
+static uint32_t chunk_scratch_size;
+
 /**
  * Write the terrain info of a chunk to memory and return a pointer to it
  *
@@ -61,6 +90,220 @@ struct chunk *chunk_write(struct chunk *c)
 	return new;
 }
 
+/**
+ * Free a chunk which has been packed.  Unlike wipe_mon_list(), this leaves
+ * the monsters counted and artifacts they hold as they are, since they live
+ * on in the packed chunk.
+ * \param c the chunk being freed
+ */
+static void chunk_release(struct chunk *c)
+{
+	int i;
+
+	for (i = 1; i < cave_monster_max(c); i++) {
+		struct monster *mon = cave_monster(c, i);
+		struct object *obj;
+
+		if (!mon->race) continue;
+		for (obj = mon->held_obj; obj; obj = obj->next) {
+			if (obj->oidx) c->objects[obj->oidx] = NULL;
+		}
+		object_pile_free(c, NULL, mon->held_obj);
+		mon->held_obj = NULL;
+	}
+
+	for (i = 1; i < z_info->level_monster_max; i++) {
+		if (c->monster_groups[i]) {
+			monster_group_free(c, c->monster_groups[i]);
+		}
+	}
+
+	cave_free(c);
+}
+
+/**
+ * Read a spilled chunk's bytes back from the spill file
+ * \param pack the packed chunk
+ * \param data where the bytes go; there must be room for pack->size of them
+ */
+static void chunk_spill_read(const struct chunk_pack *pack, uint8_t *data)
+{
+	if (!file_seek(chunk_spill, pack->offset) ||
+			file_read(chunk_spill, (char *)data, pack->size) !=
+			(int)pack->size)
+		quit("Couldn't read back a stored level");
+}
+
+/**
+ * Note that a spilled chunk no longer needs its place in the spill file;
+ * once none do, the file is thrown away
+ */
+static void chunk_spill_drop(void)
+{
+	if (--chunk_spill_count == 0) {
+		file_close(chunk_spill);
+		chunk_spill = NULL;
+		chunk_spill_size = 0;
+	}
+}
+
+/**
+ * Move the least recently used packed chunks out to the spill file until
+ * those left in memory are within the budget
+ */
+static void chunk_spill_old(void)
+{
+	size_t budget = (size_t)z_info->level_store_kb * 1024;
+
+	while (chunk_pack_bytes > budget) {
+		struct chunk_pack *oldest = NULL;
+		int i;
+
+		for (i = 0; i < chunk_list_max; i++) {
+			struct chunk_pack *pack = chunk_list[i]->pack;
+
+			if (!pack || !pack->data) continue;
+			if (!oldest || pack->used < oldest->used) oldest = pack;
+		}
+		if (!oldest) break;
+
+		/* Without the file, everything stays in memory */
+		if (!chunk_spill) {
+			chunk_spill = file_temp();
+			if (!chunk_spill) break;
+		}
+		if (!file_seek(chunk_spill, chunk_spill_size) ||
+				!file_write(chunk_spill, (char *)oldest->data,
+				oldest->size))
+			break;
+
+		oldest->offset = chunk_spill_size;
+		chunk_spill_size += oldest->size;
+		chunk_spill_count++;
+		chunk_pack_bytes -= oldest->size;
+		mem_free(oldest->data);
+		oldest->data = NULL;
+	}
+}
+
+/**
+ * Pack a stored chunk away, keeping out only the chunk itself with its
+ * name, depth, feeling, size and connectors
+ * \param c the chunk being packed
+ */
+static void chunk_pack(struct chunk *c)
+{
+	struct chunk_pack *pack = mem_zalloc(sizeof(*pack));
+	struct chunk *body = mem_alloc(sizeof(*body));
+
+	pack->data = savefile_pack_chunk(c, &pack->size);
+	pack->used = ++chunk_clock;
+	chunk_pack_bytes += pack->size;
+
+	/* Everything not kept out goes */
+	memcpy(body, c, sizeof(*body));
+	memset(c, 0, sizeof(*c));
+	c->name = body->name;
+	c->turn = body->turn;
+	c->depth = body->depth;
+	c->feeling = body->feeling;
+	c->obj_rating = body->obj_rating;
+	c->mon_rating = body->mon_rating;
+	c->good_item = body->good_item;
+	c->height = body->height;
+	c->width = body->width;
+	c->feeling_squares = body->feeling_squares;
+	c->join = body->join;
+	c->pack = pack;
+	body->name = NULL;
+	body->join = NULL;
+	chunk_release(body);
+}
+
+/**
+ * Unpack a packed chunk in place
+ * \param c the chunk being unpacked
+ */
+static void chunk_unpack(struct chunk *c)
+{
+	struct chunk_pack *pack = c->pack;
+	struct chunk *body, kept = *c;
+	uint8_t *data = pack->data;
+	int i;
+
+	if (data) {
+		chunk_pack_bytes -= pack->size;
+	} else {
+		data = mem_alloc(pack->size);
+		chunk_spill_read(pack, data);
+		chunk_spill_drop();
+	}
+	body = savefile_unpack_chunk(data, pack->size);
+	mem_free(data);
+	mem_free(pack);
+
+	/* The monsters were still counted while they were packed */
+	for (i = 1; i < cave_monster_max(body); i++) {
+		struct monster *mon = cave_monster(body, i);
+
+		if (!mon->race) continue;
+		if (mon->original_race) mon->original_race->cur_num--;
+		else mon->race->cur_num--;
+	}
+
+	/* Take on the rest of the chunk, with what was kept out as it was */
+	string_free(body->name);
+	cave_connectors_free(body->join);
+	memcpy(c, body, sizeof(*c));
+	mem_free(body);
+	c->name = kept.name;
+	c->turn = kept.turn;
+	c->depth = kept.depth;
+	c->feeling = kept.feeling;
+	c->obj_rating = kept.obj_rating;
+	c->mon_rating = kept.mon_rating;
+	c->good_item = kept.good_item;
+	c->feeling_squares = kept.feeling_squares;
+	c->join = kept.join;
+	c->pack = NULL;
+}
+
+/**
+ * Unpack a stored chunk along with its known or actual twin, so known
+ * objects can be associated as they were
+ * \param c the chunk being unpacked
+ */
+static void chunk_unpack_level(struct chunk *c)
+{
+	struct chunk *real, *known;
+	char *name = string_make(c->name);
+
+	if (suffix(name, " known")) {
+		known = c;
+		name[strlen(name) - strlen(" known")] = '\0';
+		real = strmap_get(chunk_names, name);
+	} else {
+		real = c;
+		name = string_append(name, " known");
+		known = strmap_get(chunk_names, name);
+	}
+	string_free(name);
+
+	if (real && real->pack) chunk_unpack(real);
+	if (known && known->pack) chunk_unpack(known);
+
+	/* Associate known objects */
+	if (real && known) {
+		int i;
+
+		for (i = 0; i < known->obj_max && i < real->obj_max; i++) {
+			if (real->objects[i] && known->objects[i]) {
+				real->objects[i]->known = known->objects[i];
+			}
+		}
+	}
+}
+
 /**
  * Add an entry to the chunk list - any problems with the length of this will
  * be more in the memory used by the chunks themselves rather than the list
@@ -76,6 +319,10 @@ void chunk_list_add(struct chunk *c)
 
 	/* Add the new one */
 	chunk_list[chunk_list_max++] = c;
+
+	/* Index it by name; the first of a name is the one found */
+	if (!chunk_names) chunk_names = strmap_new(false);
+	if (c->name) strmap_add(chunk_names, c->name, c);
 }
 
 /**
@@ -85,41 +332,131 @@ void chunk_list_add(struct chunk *c)
  */
 bool chunk_list_remove(const char *name)
 {
-	int i;
+	struct chunk *c = chunk_names ? strmap_get(chunk_names, name) : NULL;
+	int i, j;
 
-	/* Find the match */
-	for (i = 0; i < chunk_list_max; i++) {
-		if (streq(name, chunk_list[i]->name)) {
-			/* Copy all the succeeding chunks back one */
-			int j;
-			for (j = i + 1; j < chunk_list_max; j++) {
-				chunk_list[j - 1] = chunk_list[j];
-			}
+	if (!c) return false;
+
+	/* Find the match; a name for a chunk not in the list is stale */
+	for (i = 0; i < chunk_list_max && chunk_list[i] != c; i++) ;
+	if (i == chunk_list_max) {
+		strmap_remove(chunk_names, name);
+		return false;
+	}
+
+	/* Chunks outside the list are always unpacked */
+	if (c->pack) chunk_unpack_level(c);
 
-			/* Shorten the list and return */
-			chunk_list_max--;
-			chunk_list[chunk_list_max] = NULL;
-			return true;
+	/* Copy all the succeeding chunks back one */
+	for (j = i + 1; j < chunk_list_max; j++) {
+		chunk_list[j - 1] = chunk_list[j];
+	}
+
+	/* Shorten the list */
+	chunk_list_max--;
+	chunk_list[chunk_list_max] = NULL;
+
+	/* Any other of the same name is now the one found */
+	strmap_remove(chunk_names, name);
+	for (j = i; j < chunk_list_max; j++) {
+		if (chunk_list[j]->name && streq(name, chunk_list[j]->name)) {
+			strmap_add(chunk_names, name, chunk_list[j]);
+			break;
 		}
 	}
 
-	return false;
+	return true;
 }
 
 /**
- * Find a chunk by name
+ * Find a chunk by name, unpacking it if it has been packed
  * \param name the name of the chunk being sought
  * \return the pointer to the chunk
  */
 struct chunk *chunk_find_name(const char *name)
+{
+	struct chunk *c = chunk_peek_name(name);
+
+	if (c && c->pack) chunk_unpack_level(c);
+	return c;
+}
+
+/**
+ * Find a chunk by name without unpacking it, for when only its name, depth,
+ * feeling, size or connectors are wanted
+ * \param name the name of the chunk being sought
+ * \return the pointer to the chunk
+ */
+struct chunk *chunk_peek_name(const char *name)
+{
+	return chunk_names ? strmap_get(chunk_names, name) : NULL;
+}
+
+/**
+ * Pack the stored chunks which aren't in play, and keep those packed in
+ * memory within the budget for them
+ */
+void chunk_list_pack(void)
 {
 	int i;
 
-	for (i = 0; i < chunk_list_max; i++)
-		if (streq(name, chunk_list[i]->name))
-			return chunk_list[i];
+	for (i = 0; i < chunk_list_max; i++) {
+		struct chunk *c = chunk_list[i];
 
-	return NULL;
+		if (c->pack || c == cave || (player && c == player->cave))
+			continue;
+		chunk_pack(c);
+	}
+	chunk_spill_old();
+}
+
+/**
+ * Return the packed bytes of a packed chunk; those of a spilled chunk are
+ * only good until the next call
+ * \param c the packed chunk
+ * \param size is set to the number of bytes
+ */
+const uint8_t *chunk_pack_data(struct chunk *c, uint32_t *size)
+{
+	struct chunk_pack *pack = c->pack;
+
+	assert(pack);
+	*size = pack->size;
+	if (pack->data) return pack->data;
+
+	if (chunk_scratch_size < pack->size) {
+		chunk_scratch_size = pack->size;
+		chunk_scratch = mem_realloc(chunk_scratch, chunk_scratch_size);
+	}
+	chunk_spill_read(pack, chunk_scratch);
+	return chunk_scratch;
+}
+
+/**
+ * Free all the stored chunks and the list of them
+ */
+void chunk_list_free(void)
+{
+	int i;
+
+	/* Unpack everything so the monsters and objects go as they always did */
+	for (i = 0; i < chunk_list_max; i++) {
+		if (chunk_list[i]->pack) chunk_unpack_level(chunk_list[i]);
+	}
+	for (i = 0; i < chunk_list_max; i++) {
+		wipe_mon_list(chunk_list[i], player);
+		cave_free(chunk_list[i]);
+	}
+	mem_free(chunk_list);
+	chunk_list = NULL;
+	chunk_list_max = 0;
+
+	strmap_free(chunk_names);
+	chunk_names = NULL;
+	mem_free(chunk_scratch);
+	chunk_scratch = NULL;
+	chunk_scratch_size = 0;
+	chunk_pack_bytes = 0;
 }
 
 /**
@@ -138,7 +475,7 @@ bool chunk_find(struct chunk *c)
 }
 
 /**
- * Find the saved chunk adjacent to a given depth.
+ * Find the saved chunk adjacent to a given depth, without unpacking it.
  *
  * \param depth is the depth to use.
  * \param above if true, finds the chunk immediately above the given depth.
@@ -149,7 +486,7 @@ struct chunk *chunk_find_adjacent(int depth, bool above)
 	struct level *lev = level_by_depth(depth + ((above) ? -1 : 1));
 
 	if (lev) {
-		return chunk_find_name(lev->name);
+		return chunk_peek_name(lev->name);
 	}
 
 	return NULL;
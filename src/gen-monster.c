@@ -172,7 +172,7 @@ bool mon_restrict(const char *monster_type, int depth, int current_depth,
 			return false;
 
 		/* Prepare allocation table */
-		get_mon_num_prep(mon_pit_hook);
+		get_mon_num_prep_cached(mon_pit_hook, profile);
 		return true;
 	}
 }
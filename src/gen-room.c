@@ -2694,7 +2694,7 @@ bool build_nest(struct chunk *c, struct loc centre, int rating)
 	alloc_obj = dun->pit_type->obj_rarity;
 	
 	/* Prepare allocation table */
-	get_mon_num_prep(mon_pit_hook);
+	get_mon_num_prep_cached(mon_pit_hook, dun->pit_type);
 
 	/* Pick some monster types */
 	for (i = 0; i < 64; i++) {
@@ -2820,7 +2820,7 @@ bool build_pit(struct chunk *c, struct loc centre, int rating)
 	alloc_obj = dun->pit_type->obj_rarity;
 	
 	/* Prepare allocation table */
-	get_mon_num_prep(mon_pit_hook);
+	get_mon_num_prep_cached(mon_pit_hook, dun->pit_type);
 
 	/* Pick some monster types */
 	for (i = 0; i < 16; i++) {
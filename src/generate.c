@@ -898,7 +898,7 @@ static void get_join_info(struct player *p, struct dun_data *dd)
 	/* Check level above */
 	lev = level_by_depth(p->depth - 1);
 	if (lev) {
-		check = chunk_find_name(lev->name);
+		check = chunk_peek_name(lev->name);
 	} else {
 		check = NULL;
 	}
@@ -924,7 +924,7 @@ static void get_join_info(struct player *p, struct dun_data *dd)
 		 */
 		lev = level_by_depth(p->depth - 2);
 		if (lev) {
-			check = chunk_find_name(lev->name);
+			check = chunk_peek_name(lev->name);
 		} else {
 			check = NULL;
 		}
@@ -948,7 +948,7 @@ static void get_join_info(struct player *p, struct dun_data *dd)
 	/* Check level below */
 	lev = level_by_depth(p->depth + 1);
 	if (lev) {
-		check = chunk_find_name(lev->name);
+		check = chunk_peek_name(lev->name);
 	} else {
 		check = NULL;
 	}
@@ -969,7 +969,7 @@ static void get_join_info(struct player *p, struct dun_data *dd)
 		/* Same logic as above for looking one past the next level */
 		lev = level_by_depth(p->depth + 2);
 		if (lev) {
-			check = chunk_find_name(lev->name);
+			check = chunk_peek_name(lev->name);
 		} else {
 			check = NULL;
 		}
@@ -1362,7 +1362,7 @@ void prepare_next_level(struct player *p)
 			}
 		} else {
 			/* Save the town */
-			if (!cave->depth && !chunk_find_name("Town")) {
+			if (!cave->depth && !chunk_peek_name("Town")) {
 				cave_store(cave, false, false);
 			}
 
@@ -1511,7 +1511,7 @@ void prepare_next_level(struct player *p)
 			/* Check level above */
 			lev = level_by_depth(p->depth - 1);
 			if (lev) {
-				struct chunk *check = chunk_find_name(lev->name);
+				struct chunk *check = chunk_peek_name(lev->name);
 				if (check) {
 					get_min_level_size(check, &min_height, &min_width, true);
 				}
@@ -1520,7 +1520,7 @@ void prepare_next_level(struct player *p)
 			/* Check level below */
 			lev = level_by_depth(p->depth + 1);
 			if (lev) {
-				struct chunk *check = chunk_find_name(lev->name);
+				struct chunk *check = chunk_peek_name(lev->name);
 				if (check) {
 					get_min_level_size(check, &min_height, &min_width, false);
 				}
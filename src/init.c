@@ -64,6 +64,7 @@
 #include "player-timed.h"
 #include "project.h"
 #include "randname.h"
+#include "savefile.h"
 #include "store.h"
 #include "trap.h"
 #include "ui-entry.h"
@@ -583,6 +584,8 @@ static enum parser_error parse_constants_world(struct parser *p) {
 		z->stair_skip = value;
 	else if (streq(label, "move-energy"))
 		z->move_energy = value;
+	else if (streq(label, "level-store-kb"))
+		z->level_store_kb = value;
 	else
 		return PARSE_ERROR_UNDEFINED_DIRECTIVE;
 
@@ -2280,6 +2283,8 @@ static errr finish_parse_feat(struct parser *p) {
 
 static void cleanup_feat(void) {
 	int idx;
+
+	reset_feat_lookups();
 	for (idx = 0; idx < FEAT_MAX; idx++) {
 		string_free(f_info[idx].look_in_preposition);
 		string_free(f_info[idx].look_prefix);
@@ -4508,13 +4513,11 @@ void cleanup_angband(void)
 {
 	int i;
 
+	/* Let a save still being written finish */
+	(void) savefile_wait();
+
 	/* Free the chunk list */
-	for (i = 0; i < chunk_list_max; i++) {
-		wipe_mon_list(chunk_list[i], player);
-		cave_free(chunk_list[i]);
-	}
-	mem_free(chunk_list);
-	chunk_list = NULL;
+	chunk_list_free();
 
 	for (i = 0; modules[i]; i++)
 		if (modules[i]->cleanup)
@@ -4541,6 +4544,9 @@ void cleanup_angband(void)
 	/* Free the format() buffer */
 	vformat_kill();
 
+	/* Free the tables of flag names */
+	cleanup_name_tables();
+
 	/* Free the directories */
 	string_free(ANGBAND_DIR_GAMEDATA);
 	string_free(ANGBAND_DIR_CUSTOMIZE);
@@ -116,6 +116,8 @@ struct angband_constants
 	uint16_t feeling_need;	/* Squares needed to see to get first feeling */
 	uint16_t stair_skip;	/* Number of levels to skip for each down stair */
 	uint16_t move_energy;	/* Energy the player or monster needs to move */
+	uint16_t level_store_kb;	/**< Kilobytes of memory for stored levels
+					 * which aren't in play */
 
 	/* Carrying capacity constants, read from constants.txt */
 	uint16_t pack_size;		/**< Maximum number of pack slots */
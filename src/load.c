@@ -171,8 +171,7 @@ static struct object *rd_item(void)
 	}
 	rd_byte(&obj->notice);
 
-	for (i = 0; i < of_size; i++)
-		rd_byte(&obj->flags[i]);
+	rd_bytes(obj->flags, of_size);
 
 	for (i = 0; i < obj_mod_max; i++) {
 		rd_s16b(&obj->modifiers[i]);
@@ -295,11 +294,9 @@ static bool rd_monster(struct chunk *c, struct monster *mon)
 		rd_s16b(&mon->m_timed[j]);
 
 	/* Read and extract the flag */
-	for (j = 0; j < mflag_size; j++)
-		rd_byte(&mon->mflag[j]);
+	rd_bytes(mon->mflag, mflag_size);
 
-	for (j = 0; j < of_size; j++)
-		rd_byte(&mon->known_pstate.flags[j]);
+	rd_bytes(mon->known_pstate.flags, of_size);
 
 	for (j = 0; j < elem_max; j++)
 		rd_s16b(&mon->known_pstate.el_info[j].res_level);
@@ -358,7 +355,6 @@ static bool rd_monster(struct chunk *c, struct monster *mon)
  */
 static void rd_trap(struct trap *trap)
 {
-	int i;
 	uint8_t tmp8u;
 	char buf[80];
 
@@ -374,8 +370,7 @@ static void rd_trap(struct trap *trap)
 	rd_byte(&trap->power);
 	rd_byte(&trap->timeout);
 
-	for (i = 0; i < trf_size; i++)
-		rd_byte(&trap->flags[i]);
+	rd_bytes(trap->flags, trf_size);
 }
 
 /**
@@ -541,6 +536,9 @@ int rd_monster_memory(void)
 		rd_string(buf, sizeof(buf));
 	}
 
+	/* Uniques may have come back or died */
+	invalidate_mon_num_tables();
+
 	return 0;
 }
 
@@ -989,8 +987,7 @@ int rd_misc(void)
 
 	/* Property knowledge */
 	/* Flags */
-	for (i = 0; i < OF_SIZE; i++)
-		rd_byte(&player->obj_k->flags[i]);
+	rd_bytes(player->obj_k->flags, OF_SIZE);
 
 	/* Modifiers */
 	for (i = 0; i < OBJ_MOD_MAX; i++) {
@@ -1611,6 +1608,93 @@ int rd_traps(void)
 	return 0;
 }
 
+/**
+ * Read a stored chunk
+ */
+static int rd_chunk(struct chunk **c)
+{
+	/* Read the dungeon */
+	if (rd_dungeon_aux(c))
+		return -1;
+
+	/* Read the objects */
+	if (rd_objects_aux(rd_item, *c))
+		return -1;
+
+	/* Read the monsters */
+	if (rd_monsters_aux(*c))
+		return -1;
+
+	/* Read traps */
+	if (rd_traps_aux(*c))
+		return -1;
+
+
+	/* Read other chunk info */
+	if (OPT(player, birth_levels_persist)) {
+		char buf[80];
+		int i;
+		uint8_t tmp8u;
+		uint16_t tmp16u;
+
+		rd_string(buf, sizeof(buf));
+		string_free((*c)->name);
+		(*c)->name = string_make(buf);
+		rd_s32b(&(*c)->turn);
+		rd_u16b(&tmp16u);
+		(*c)->depth = tmp16u;
+		rd_byte(&(*c)->feeling);
+		rd_u32b(&(*c)->obj_rating);
+		rd_u32b(&(*c)->mon_rating);
+		rd_byte(&tmp8u);
+		(*c)->good_item  = tmp8u ? true : false;
+		rd_u16b(&tmp16u);
+		(*c)->height = tmp16u;
+		rd_u16b(&tmp16u);
+		(*c)->width = tmp16u;
+		rd_u16b(&(*c)->feeling_squares);
+		for (i = 0; i < FEAT_MAX + 1; i++) {
+			rd_u16b(&tmp16u);
+			(*c)->feat_count[i] = tmp16u;
+		}
+	} else if ((*c)->name) {
+		char *name = (*c)->name;
+		struct level *lev = level_by_name(name);
+
+		if (lev) {
+			(*c)->depth = lev->depth;
+		} else if (suffix(name, " known")) {
+			size_t offset = strlen(name) - strlen(" known");
+			name[offset] = '\0';
+			lev = level_by_name(name);
+			if (lev) {
+				(*c)->depth = lev->depth;
+			}
+			name[offset] = ' ';
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * Read a chunk packed by wr_chunk() in this game rather than from a
+ * savefile, so with the sizes of things as they are now
+ */
+int rd_packed_chunk(struct chunk **c)
+{
+	square_size = SQUARE_SIZE;
+	of_size = OF_SIZE;
+	obj_mod_max = OBJ_MOD_MAX;
+	elem_max = ELEM_MAX;
+	brand_max = z_info->brand_max;
+	slay_max = z_info->slay_max;
+	curse_max = z_info->curse_max;
+	mflag_size = MFLAG_SIZE;
+
+	return rd_chunk(c);
+}
+
 /**
  * Read the chunk list
  */
@@ -1626,67 +1710,9 @@ int rd_chunks(void)
 	for (j = 0; j < chunk_max; j++) {
 		struct chunk *c = NULL;
 
-		/* Read the dungeon */
-		if (rd_dungeon_aux(&c))
+		if (rd_chunk(&c))
 			return -1;
 
-		/* Read the objects */
-		if (rd_objects_aux(rd_item, c))
-			return -1;
-
-		/* Read the monsters */
-		if (rd_monsters_aux(c))
-			return -1;
-
-		/* Read traps */
-		if (rd_traps_aux(c))
-			return -1;
-
-
-		/* Read other chunk info */
-		if (OPT(player, birth_levels_persist)) {
-			char buf[80];
-			int i;
-			uint8_t tmp8u;
-			uint16_t tmp16u;
-
-			rd_string(buf, sizeof(buf));
-			string_free(c->name);
-			c->name = string_make(buf);
-			rd_s32b(&c->turn);
-			rd_u16b(&tmp16u);
-			c->depth = tmp16u;
-			rd_byte(&c->feeling);
-			rd_u32b(&c->obj_rating);
-			rd_u32b(&c->mon_rating);
-			rd_byte(&tmp8u);
-			c->good_item  = tmp8u ? true : false;
-			rd_u16b(&tmp16u);
-			c->height = tmp16u;
-			rd_u16b(&tmp16u);
-			c->width = tmp16u;
-			rd_u16b(&c->feeling_squares);
-			for (i = 0; i < FEAT_MAX + 1; i++) {
-				rd_u16b(&tmp16u);
-				c->feat_count[i] = tmp16u;
-			}
-		} else if (c->name) {
-			struct level *lev = level_by_name(c->name);
-
-			if (lev) {
-				c->depth = lev->depth;
-			} else if (suffix(c->name, " known")) {
-				size_t offset = strlen(c->name) -
-					strlen(" known");
-				c->name[offset] = '\0';
-				lev = level_by_name(c->name);
-				if (lev) {
-					c->depth = lev->depth;
-				}
-				c->name[offset] = ' ';
-			}
-		}
-
 		chunk_list_add(c);
 	}
 
@@ -1709,7 +1735,7 @@ int rd_chunks(void)
 int rd_history(void)
 {
 	uint32_t tmp32u;
-	size_t i, j;
+	size_t i;
 	
 	history_clear(player);
 
@@ -1730,8 +1756,7 @@ int rd_history(void)
 		char name[80];
 		char text[80];
 
-		for (j = 0; j < hist_size; j++)		
-			rd_byte(&type[j]);
+		rd_bytes(type, hist_size);
 		rd_s32b(&turnno);
 		rd_s16b(&dlev);
 		rd_s16b(&clev);
@@ -193,15 +193,71 @@ static const char g_ascii_codepoints_for_cache[] =
  * displays, anyway) */
 #define ASCII_CACHE_SIZE \
 		(N_ELEMENTS(g_ascii_codepoints_for_cache) - 1)
+/* Atlas of the other glyphs, filled as they are first drawn; it grows by
+ * doubling its rows up to a limit, and then the least recently drawn glyphs
+ * make room for new ones */
+#define GLYPH_ATLAS_COLS 16
+#define GLYPH_ATLAS_MIN_ROWS 4
+#define GLYPH_ATLAS_MAX_ROWS 64
+#define GLYPH_ATLAS_BUCKETS 256
+struct glyph_slot {
+	uint32_t codepoint;
+	/* atlas clock when last drawn */
+	uint32_t used;
+	/* next slot + 1 in the same hash bucket; 0 ends the chain */
+	int next;
+};
+struct glyph_atlas {
+	SDL_Texture *texture;
+	/* rows of slots in the texture, each GLYPH_ATLAS_COLS across */
+	int rows;
+	/* slots filled, in order */
+	int count;
+	struct glyph_slot *slots;
+	/* first slot + 1 for each hash bucket; 0 if empty */
+	int buckets[GLYPH_ATLAS_BUCKETS];
+	uint32_t clock;
+};
 struct font_cache {
 	SDL_Texture *texture;
 	/* it wastes some space... so what? */
 	SDL_Rect rects[ASCII_CACHE_SIZE];
+	struct glyph_atlas atlas;
 };
 /* 0 is also a valid codepoint, of course... that's just for finding bugs */
 #define IS_CACHED_ASCII_CODEPOINT(c) \
 		((c) > 0 && (c) < ASCII_CACHE_SIZE)
 
+/* Glyphs, tiles and fills for a term are queued as quads by the term hooks
+ * and drawn to the subwindow's texture together when the term is refreshed,
+ * one call for each kind, in this order */
+#define QUAD_BATCH_MIN 64
+/* A batch is drawn with one SDL_RenderGeometry() where SDL has it; defining
+ * SDL2_NO_GEOMETRY draws a quad at a time, as older versions of SDL must */
+#if SDL_VERSION_ATLEAST(2, 0, 18) && !defined(SDL2_NO_GEOMETRY)
+#define USE_QUAD_GEOMETRY
+#endif
+enum quad_kind {
+	QUAD_FILL,
+	QUAD_TEXT,
+	QUAD_ATLAS,
+	QUAD_TILE,
+
+	QUAD_MAX
+};
+struct quad {
+	SDL_Rect src;
+	SDL_Rect dst;
+	SDL_Color color;
+};
+struct quad_batch {
+	/* all quads in a batch come from this texture; NULL for fills */
+	SDL_Texture *texture;
+	struct quad *quads;
+	int count;
+	int size;
+};
+
 struct font {
 	struct ttf ttf;
 	char *name;
@@ -285,6 +341,8 @@ struct subwindow {
 	struct subwindow_border borders;
 
 	SDL_Texture *texture;
+	/** what the term hooks have drawn that isn't yet in texture */
+	struct quad_batch batches[QUAD_MAX];
 
 	struct font *font;
 
@@ -358,6 +416,20 @@ struct sdlpui_window {
 	/** from display mode */
 	int delay;
 
+	/** time spent drawing frames, in performance counter ticks, and how
+	 * many; printed with the SDL details when the window is freed */
+	Uint64 frame_time;
+	Uint32 frames;
+	/** quads drawn from batches and the calls it took */
+	Uint32 quads;
+	Uint32 draw_calls;
+#ifdef USE_QUAD_GEOMETRY
+	/** scratch space for drawing a batch of quads as geometry */
+	SDL_Vertex *vertices;
+	int *indices;
+	int geometry_size;
+#endif
+
 	/** as reported by SDL_GetWindowFlags() */
 	Uint32 flags;
 
@@ -498,6 +570,8 @@ static const struct font_info *find_font_info(const struct font_info *fonts,
 		int nfonts, const char *name);
 static struct font *make_font(const struct sdlpui_window *window,
 		const char *name, int size);
+static SDL_Texture *make_subwindow_texture(const struct sdlpui_window *window,
+		int w, int h);
 static struct sdlpui_window *get_new_window(struct my_app *a, unsigned index);
 static void wipe_window(struct sdlpui_window *window, int display);
 /* create default config for spawning a window via gui */
@@ -880,11 +954,191 @@ static void render_fill_rect(const struct sdlpui_window *window,
 	SDL_RenderFillRect(window->renderer, rect);
 }
 
+#ifdef USE_QUAD_GEOMETRY
+/** draws the whole batch with one SDL_RenderGeometry(); does not
+ * SetRenderTarget */
+static int render_quad_geometry(struct sdlpui_window *window,
+		const struct quad_batch *batch)
+{
+	float tex_w = 1.0f;
+	float tex_h = 1.0f;
+
+	if (batch->texture != NULL) {
+		int w, h;
+
+		if (SDL_QueryTexture(batch->texture, NULL, NULL, &w, &h) != 0) {
+			return -1;
+		}
+		tex_w = (float) w;
+		tex_h = (float) h;
+	}
+
+	if (window->geometry_size < batch->count) {
+		window->geometry_size = batch->size;
+		window->vertices = mem_realloc(window->vertices,
+				4 * window->geometry_size * sizeof(*window->vertices));
+		window->indices = mem_realloc(window->indices,
+				6 * window->geometry_size * sizeof(*window->indices));
+	}
+
+	for (int i = 0; i < batch->count; i++) {
+		const struct quad *quad = &batch->quads[i];
+		SDL_Vertex *v = &window->vertices[4 * i];
+		int *index = &window->indices[6 * i];
+		float x0 = (float) quad->dst.x;
+		float y0 = (float) quad->dst.y;
+		float x1 = (float) (quad->dst.x + quad->dst.w);
+		float y1 = (float) (quad->dst.y + quad->dst.h);
+		float u0 = quad->src.x / tex_w;
+		float v0 = quad->src.y / tex_h;
+		float u1 = (quad->src.x + quad->src.w) / tex_w;
+		float v1 = (quad->src.y + quad->src.h) / tex_h;
+
+		/* corners clockwise from the top left; two triangles */
+		v[0].position.x = x0; v[0].position.y = y0;
+		v[0].tex_coord.x = u0; v[0].tex_coord.y = v0;
+		v[1].position.x = x1; v[1].position.y = y0;
+		v[1].tex_coord.x = u1; v[1].tex_coord.y = v0;
+		v[2].position.x = x1; v[2].position.y = y1;
+		v[2].tex_coord.x = u1; v[2].tex_coord.y = v1;
+		v[3].position.x = x0; v[3].position.y = y1;
+		v[3].tex_coord.x = u0; v[3].tex_coord.y = v1;
+		for (int j = 0; j < 4; j++) {
+			v[j].color = quad->color;
+		}
+
+		index[0] = 4 * i;
+		index[1] = 4 * i + 1;
+		index[2] = 4 * i + 2;
+		index[3] = 4 * i;
+		index[4] = 4 * i + 2;
+		index[5] = 4 * i + 3;
+	}
+
+	return SDL_RenderGeometry(window->renderer, batch->texture,
+			window->vertices, 4 * batch->count,
+			window->indices, 6 * batch->count);
+}
+#endif
+
+/** does not SetRenderTarget */
+static void render_quad_batch(struct sdlpui_window *window,
+		struct quad_batch *batch)
+{
+	if (batch->count == 0) {
+		return;
+	}
+
+	window->quads += batch->count;
+
+#ifdef USE_QUAD_GEOMETRY
+	if (render_quad_geometry(window, batch) == 0) {
+		window->draw_calls++;
+		batch->count = 0;
+		return;
+	}
+#endif
+
+	/* No geometry; a copy or fill for each quad, as it used to be */
+	for (int i = 0; i < batch->count; i++) {
+		const struct quad *quad = &batch->quads[i];
+
+		if (batch->texture != NULL) {
+			SDL_SetTextureColorMod(batch->texture,
+					quad->color.r, quad->color.g, quad->color.b);
+			SDL_RenderCopy(window->renderer, batch->texture,
+					&quad->src, &quad->dst);
+		} else {
+			SDL_SetRenderDrawColor(window->renderer, quad->color.r,
+					quad->color.g, quad->color.b, quad->color.a);
+			SDL_RenderFillRect(window->renderer, &quad->dst);
+		}
+	}
+	window->draw_calls += batch->count;
+	batch->count = 0;
+}
+
+/** draws everything queued for the subwindow to its texture; does
+ * SetRenderTarget */
+static void flush_quads(struct subwindow *subwindow)
+{
+	bool target = false;
+
+	for (int i = 0; i < QUAD_MAX; i++) {
+		if (subwindow->batches[i].count == 0) {
+			continue;
+		}
+		if (!target) {
+			SDL_SetRenderTarget(subwindow->window->renderer,
+					subwindow->texture);
+			target = true;
+		}
+		render_quad_batch(subwindow->window, &subwindow->batches[i]);
+	}
+}
+
+/** forgets what is queued, for when it would be drawn over or its
+ * textures are gone */
+static void discard_quads(struct subwindow *subwindow)
+{
+	for (int i = 0; i < QUAD_MAX; i++) {
+		subwindow->batches[i].count = 0;
+	}
+}
+
+static void free_quads(struct subwindow *subwindow)
+{
+	for (int i = 0; i < QUAD_MAX; i++) {
+		mem_free(subwindow->batches[i].quads);
+	}
+	memset(subwindow->batches, 0, sizeof(subwindow->batches));
+}
+
+/** queues a quad to be drawn to the subwindow's texture; src is not used
+ * for fills */
+static void add_quad(struct subwindow *subwindow, enum quad_kind kind,
+		SDL_Texture *texture, const SDL_Rect *src, const SDL_Rect *dst,
+		const SDL_Color *color)
+{
+	struct quad_batch *batch = &subwindow->batches[kind];
+
+	if (batch->count > 0 && batch->texture != texture) {
+		/* Keep the order things were drawn in */
+		flush_quads(subwindow);
+	}
+	if (batch->count == batch->size) {
+		batch->size = batch->size ? 2 * batch->size : QUAD_BATCH_MIN;
+		batch->quads = mem_realloc(batch->quads,
+				batch->size * sizeof(*batch->quads));
+	}
+
+	struct quad *quad = &batch->quads[batch->count++];
+
+	batch->texture = texture;
+	if (src != NULL) {
+		quad->src = *src;
+	} else {
+		memset(&quad->src, 0, sizeof(quad->src));
+	}
+	quad->dst = *dst;
+	quad->color = *color;
+}
+
+static void flush_all_quads(struct sdlpui_window *window)
+{
+	for (size_t i = 0; i < N_ELEMENTS(window->subwindows); i++) {
+		if (window->subwindows[i] != NULL) {
+			flush_quads(window->subwindows[i]);
+		}
+	}
+}
+
 static void render_all(struct sdlpui_window *window)
 {
 	size_t i;
 	struct sdlpui_dialog *d;
 
+	flush_all_quads(window);
 	render_background(window);
 
 	for (d = window->d_tail; d; d = d->prev) {
@@ -934,6 +1188,7 @@ static void render_window_while_menu_active(struct sdlpui_window *window)
 	size_t i;
 	struct sdlpui_dialog *d;
 
+	flush_all_quads(window);
 	render_background(window);
 
 	SDL_SetRenderTarget(window->renderer, NULL);
@@ -1011,10 +1266,15 @@ static void set_subwindows_alpha(const struct sdlpui_window *window, int alpha)
  * needed while playing the game, like moving terms */
 static void redraw_window_while_menu_active(struct sdlpui_window *window)
 {
+	Uint64 start = SDL_GetPerformanceCounter();
+
 	set_subwindows_alpha(window, window->alpha);
 	render_window_while_menu_active(window);
 	SDL_RenderPresent(window->renderer);
 	window->next_redraw = SDL_GetTicks() + window->delay;
+
+	window->frame_time += SDL_GetPerformanceCounter() - start;
+	window->frames++;
 }
 
 /** this function is mostly used while normally playing the game */
@@ -1026,9 +1286,30 @@ static void redraw_window(struct sdlpui_window *window)
 		return;
 	}
 
+	Uint64 start = SDL_GetPerformanceCounter();
+
 	render_all(window);
 	SDL_RenderPresent(window->renderer);
 	window->next_redraw = SDL_GetTicks() + window->delay;
+
+	window->frame_time += SDL_GetPerformanceCounter() - start;
+	window->frames++;
+}
+
+static void log_frame_stats(const struct sdlpui_window *window)
+{
+	if (window->frames == 0) {
+		return;
+	}
+
+	SDL_Log("Window %u: %lu frames, %.3f ms per frame; "
+		"%lu quads in %lu draw calls", window->index,
+		(unsigned long) window->frames,
+		1000.0 * (double) window->frame_time
+		/ (double) SDL_GetPerformanceFrequency()
+		/ (double) window->frames,
+		(unsigned long) window->quads,
+		(unsigned long) window->draw_calls);
 }
 
 static void try_redraw_window(struct sdlpui_window *window)
@@ -1050,10 +1331,159 @@ static void redraw_all_windows(struct my_app *a, bool dirty)
 	}
 }
 
+static SDL_Rect get_glyph_atlas_rect(const struct font *font, int slot)
+{
+	SDL_Rect rect = {
+		font->ttf.glyph.w * (slot % GLYPH_ATLAS_COLS),
+		font->ttf.glyph.h * (slot / GLYPH_ATLAS_COLS),
+		font->ttf.glyph.w,
+		font->ttf.glyph.h
+	};
+
+	return rect;
+}
+
+static void free_glyph_atlas(struct glyph_atlas *atlas)
+{
+	if (atlas->texture != NULL) {
+		SDL_DestroyTexture(atlas->texture);
+	}
+	mem_free(atlas->slots);
+	memset(atlas, 0, sizeof(*atlas));
+}
+
+/** does SetRenderTarget (to the atlas); returns false if the atlas can't
+ * get any bigger */
+static bool grow_glyph_atlas(const struct sdlpui_window *window,
+		const struct font *font, struct glyph_atlas *atlas)
+{
+	const int glyph_w = font->ttf.glyph.w;
+	const int glyph_h = font->ttf.glyph.h;
+	int rows = atlas->rows ? 2 * atlas->rows : GLYPH_ATLAS_MIN_ROWS;
+	int max_rows = GLYPH_ATLAS_MAX_ROWS;
+	SDL_RendererInfo info;
+
+	/* Stay within what the renderer allows for textures */
+	if (SDL_GetRendererInfo(window->renderer, &info) == 0
+			&& info.max_texture_height > 0) {
+		max_rows = MIN(max_rows, info.max_texture_height / glyph_h);
+	}
+	if (rows > max_rows) {
+		return false;
+	}
+
+	SDL_Texture *texture = make_subwindow_texture(window,
+			GLYPH_ATLAS_COLS * glyph_w, rows * glyph_h);
+
+	/* fill texture with white transparent pixels */
+	SDL_Color white = {0xFF, 0xFF, 0xFF, 0};
+	render_clear(window, texture, &white);
+
+	/* Keep the glyphs already there, untinted and as they are */
+	if (atlas->texture != NULL) {
+		SDL_Rect rect = {0, 0,
+			GLYPH_ATLAS_COLS * glyph_w, atlas->rows * glyph_h};
+
+		SDL_SetTextureBlendMode(atlas->texture, SDL_BLENDMODE_NONE);
+		SDL_SetTextureColorMod(atlas->texture, 0xFF, 0xFF, 0xFF);
+		SDL_RenderCopy(window->renderer, atlas->texture, &rect, &rect);
+		SDL_DestroyTexture(atlas->texture);
+	}
+
+	atlas->texture = texture;
+	atlas->slots = mem_realloc(atlas->slots,
+			rows * GLYPH_ATLAS_COLS * sizeof(*atlas->slots));
+	atlas->rows = rows;
+
+	return true;
+}
+
+/** returns the slot for the glyph if it is in the font's atlas, or -1 */
+static int find_glyph_atlas_slot(struct font *font, uint32_t codepoint)
+{
+	struct glyph_atlas *atlas = &font->cache.atlas;
+
+	for (int i = atlas->buckets[codepoint % GLYPH_ATLAS_BUCKETS]; i;
+			i = atlas->slots[i - 1].next) {
+		if (atlas->slots[i - 1].codepoint == codepoint) {
+			atlas->slots[i - 1].used = ++atlas->clock;
+			return i - 1;
+		}
+	}
+
+	return -1;
+}
+
+/** returns the slot for the glyph in the font's atlas, rendering it there if
+ * it isn't yet, or -1 if it can't be rendered; if it renders the glyph, it
+ * sets the render target back to dst_texture */
+static int get_glyph_atlas_slot(const struct sdlpui_window *window,
+		struct font *font, SDL_Texture *dst_texture, uint32_t codepoint)
+{
+	struct glyph_atlas *atlas = &font->cache.atlas;
+	int *link = &atlas->buckets[codepoint % GLYPH_ATLAS_BUCKETS];
+	int slot = find_glyph_atlas_slot(font, codepoint);
+
+	if (slot >= 0) {
+		return slot;
+	}
+
+	SDL_Color white = {0xFF, 0xFF, 0xFF, 0xFF};
+	SDL_Surface *surface = TTF_RenderGlyph_Blended(font->ttf.handle,
+			(Uint16) codepoint, white);
+	if (surface == NULL) {
+		return -1;
+	}
+	SDL_Texture *texture = SDL_CreateTextureFromSurface(window->renderer, surface);
+	if (texture == NULL) {
+		SDL_FreeSurface(surface);
+		return -1;
+	}
+
+	if (atlas->count < atlas->rows * GLYPH_ATLAS_COLS
+			|| grow_glyph_atlas(window, font, atlas)) {
+		slot = atlas->count++;
+	} else {
+		/* Full; take the slot of the glyph drawn longest ago */
+		slot = 0;
+		for (int i = 1; i < atlas->count; i++) {
+			if (atlas->slots[i].used < atlas->slots[slot].used) {
+				slot = i;
+			}
+		}
+		int *old = &atlas->buckets[atlas->slots[slot].codepoint
+				% GLYPH_ATLAS_BUCKETS];
+		while (*old != slot + 1) {
+			old = &atlas->slots[*old - 1].next;
+		}
+		*old = atlas->slots[slot].next;
+	}
+
+	/* Draw the glyph in white, like the ASCII cache, over what was there */
+	SDL_Rect src = {0, 0, surface->w, surface->h};
+	SDL_Rect dst = get_glyph_atlas_rect(font, slot);
+	SDL_Color clear = {0xFF, 0xFF, 0xFF, 0};
+
+	render_fill_rect(window, atlas->texture, &dst, &clear);
+	crop_rects(&src, &dst);
+	SDL_RenderCopy(window->renderer, texture, &src, &dst);
+	SDL_SetRenderTarget(window->renderer, dst_texture);
+
+	SDL_FreeSurface(surface);
+	SDL_DestroyTexture(texture);
+
+	atlas->slots[slot].codepoint = codepoint;
+	atlas->slots[slot].used = ++atlas->clock;
+	atlas->slots[slot].next = *link;
+	*link = slot + 1;
+
+	return slot;
+}
+
 /** this function is typically called in a loop, so for efficiency it doesn't
  * SetRenderTarget; caller must do it (but it does SetTextureColorMod) */
 static void render_glyph_mono(const struct sdlpui_window *window,
-		const struct font *font, SDL_Texture *dst_texture,
+		struct font *font, SDL_Texture *dst_texture,
 		int x, int y, const SDL_Color *fg, uint32_t codepoint)
 {
 	if (codepoint == ' ') {
@@ -1072,23 +1502,62 @@ static void render_glyph_mono(const struct sdlpui_window *window,
 		SDL_RenderCopy(window->renderer,
 				font->cache.texture, &font->cache.rects[codepoint], &dst);
 	} else {
-		SDL_Surface *surface = TTF_RenderGlyph_Blended(font->ttf.handle,
-				(Uint16) codepoint, *fg);
-		if (surface == NULL) {
+		int slot = get_glyph_atlas_slot(window, font, dst_texture,
+				codepoint);
+		if (slot < 0) {
 			return;
 		}
 
-		SDL_Texture *texture = SDL_CreateTextureFromSurface(window->renderer, surface);
-		assert(texture != NULL);
+		SDL_Texture *atlas = font->cache.atlas.texture;
+		SDL_Rect src = get_glyph_atlas_rect(font, slot);
 
-		SDL_Rect src = {0, 0, surface->w, surface->h};
+		SDL_SetTextureColorMod(atlas, fg->r, fg->g, fg->b);
+
+		SDL_RenderCopy(window->renderer, atlas, &src, &dst);
+	}
+}
+
+/** queues the glyph to be drawn to the subwindow's texture, like
+ * render_glyph_mono() would draw it */
+static void queue_glyph(struct subwindow *subwindow,
+		int x, int y, const SDL_Color *fg, uint32_t codepoint)
+{
+	struct font *font = subwindow->font;
+	SDL_Color color = {fg->r, fg->g, fg->b, 0xFF};
+
+	if (codepoint == ' ') {
+		return;
+	}
+
+	SDL_Rect dst = {x, y, font->ttf.glyph.w, font->ttf.glyph.h};
+
+	if (IS_CACHED_ASCII_CODEPOINT(codepoint)) {
+		SDL_Rect src = font->cache.rects[codepoint];
 
 		crop_rects(&src, &dst);
 
-		SDL_RenderCopy(window->renderer, texture, &src, &dst);
+		add_quad(subwindow, QUAD_TEXT, font->cache.texture,
+				&src, &dst, &color);
+	} else {
+		int slot = find_glyph_atlas_slot(font, codepoint);
 
-		SDL_FreeSurface(surface);
-		SDL_DestroyTexture(texture);
+		if (slot < 0) {
+			/*
+			 * Adding to the atlas may move or replace glyphs that
+			 * queued quads still use, so draw those first
+			 */
+			flush_quads(subwindow);
+			slot = get_glyph_atlas_slot(subwindow->window, font,
+					subwindow->texture, codepoint);
+			if (slot < 0) {
+				return;
+			}
+		}
+
+		SDL_Rect src = get_glyph_atlas_rect(font, slot);
+
+		add_quad(subwindow, QUAD_ATLAS, font->cache.atlas.texture,
+				&src, &dst, &color);
 	}
 }
 
@@ -1179,10 +1648,12 @@ static void render_tile_rect_scaled(const struct subwindow *subwindow,
 			graphics->texture, &src, &dst);
 }
 
-static void render_tile_font_scaled(const struct subwindow *subwindow,
+/** queues the tile to be drawn to the subwindow's texture */
+static void queue_tile_font_scaled(struct subwindow *subwindow,
 		int col, int row, int a, int c, bool fill, int dhrclip)
 {
 	struct graphics *graphics = &subwindow->window->graphics;
+	SDL_Color white = {0xFF, 0xFF, 0xFF, 0xFF};
 
 	SDL_Rect dst = {
 		subwindow->inner_rect.x + col * subwindow->font_width,
@@ -1192,13 +1663,11 @@ static void render_tile_font_scaled(const struct subwindow *subwindow,
 	};
 
 	if (fill) {
-		render_fill_rect(subwindow->window, subwindow->texture, &dst, &subwindow->color);
+		add_quad(subwindow, QUAD_FILL, NULL, NULL, &dst, &subwindow->color);
 	}
 
 	SDL_Rect src = {0, 0, graphics->tile_pixel_w, graphics->tile_pixel_h};
 
-	SDL_SetRenderTarget(subwindow->window->renderer, subwindow->texture);
-
 	int src_row = a & 0x7f;
 	int src_col = c & 0x7f;
 
@@ -1214,13 +1683,9 @@ static void render_tile_font_scaled(const struct subwindow *subwindow,
 		dst.y -= dst.h;
 		dst.h *= 2;
 		src.h *= 2;
-
-		SDL_RenderCopy(subwindow->window->renderer,
-				graphics->texture, &src, &dst);
-	} else {
-		SDL_RenderCopy(subwindow->window->renderer,
-				graphics->texture, &src, &dst);
 	}
+
+	add_quad(subwindow, QUAD_TILE, graphics->texture, &src, &dst, &white);
 }
 
 static void render_grid_cell_tile(const struct subwindow *subwindow,
@@ -3740,6 +4205,7 @@ static void handle_windowevent(struct my_app *a, const SDL_WindowEvent *event)
 
 static void resize_subwindow(struct subwindow *subwindow)
 {
+	discard_quads(subwindow);
 	SDL_DestroyTexture(subwindow->texture);
 
 	subwindow->full_rect = subwindow->sizing_rect;
@@ -4789,6 +5255,8 @@ static errr term_xtra_clear(void)
 	struct subwindow *subwindow = Term->data;
 	assert(subwindow != NULL);
 
+	/* Whatever is queued would be drawn over */
+	discard_quads(subwindow);
 	render_fill_rect(subwindow->window,
 			subwindow->texture, &subwindow->inner_rect, &subwindow->color);
 
@@ -4802,7 +5270,11 @@ static errr term_xtra_fresh(void)
 	struct subwindow *subwindow = Term->data;
 	assert(subwindow != NULL);
 
-	if (!subwindow->window->d_mouse && !subwindow->window->d_key) {
+	flush_quads(subwindow);
+
+	/* Nothing to show if the hooks drew nothing since the last frame */
+	if (subwindow->window->dirty && !subwindow->window->d_mouse
+			&& !subwindow->window->d_key) {
 		try_redraw_window(subwindow->window);
 	}
 
@@ -4851,6 +5323,7 @@ static errr term_curs_hook(int col, int row)
 	struct subwindow *subwindow = Term->data;
 	assert(subwindow != NULL);
 
+	flush_quads(subwindow);
 	render_cursor(subwindow, col, row, false);
 
 	subwindow->window->dirty = true;
@@ -4863,6 +5336,7 @@ static errr term_bigcurs_hook(int col, int row)
 	struct subwindow *subwindow = Term->data;
 	assert(subwindow != NULL);
 
+	flush_quads(subwindow);
 	render_cursor(subwindow, col, row, true);
 
 	subwindow->window->dirty = true;
@@ -4882,7 +5356,7 @@ static errr term_wipe_hook(int col, int row, int n)
 		subwindow->font_height
 	};
 
-	render_fill_rect(subwindow->window, subwindow->texture, &rect, &subwindow->color);
+	add_quad(subwindow, QUAD_FILL, NULL, NULL, &rect, &subwindow->color);
 
 	subwindow->window->dirty = true;
 
@@ -4922,13 +5396,11 @@ static errr term_text_hook(int col, int row, int n, int a, const wchar_t *s)
 		subwindow->font_height
 	};
 
-	render_fill_rect(subwindow->window, subwindow->texture, &rect, &bg);
+	add_quad(subwindow, QUAD_FILL, NULL, NULL, &rect, &bg);
 
 	rect.w = subwindow->font_width;
 	for (int i = 0; i < n; i++) {
-		render_glyph_mono(subwindow->window,
-				subwindow->font, subwindow->texture,
-				rect.x, rect.y, &fg, (uint32_t) s[i]);
+		queue_glyph(subwindow, rect.x, rect.y, &fg, (uint32_t) s[i]);
 		rect.x += subwindow->font_width;
 	}
 
@@ -4965,13 +5437,13 @@ static errr term_pict_hook(int col, int row, int n,
 	}
 
 	for (int i = 0; i < n; i++) {
-		render_tile_font_scaled(subwindow, col + i, row, tap[i], tcp[i], true, dhrclip);
+		queue_tile_font_scaled(subwindow, col + i, row, tap[i], tcp[i], true, dhrclip);
 
 		if (tap[i] == ap[i] && tcp[i] == cp[i]) {
 			continue;
 		}
 
-		render_tile_font_scaled(subwindow, col + i, row, ap[i], cp[i], false, dhrclip);
+		queue_tile_font_scaled(subwindow, col + i, row, ap[i], cp[i], false, dhrclip);
 	}
 
 	subwindow->window->dirty = true;
@@ -5476,7 +5948,13 @@ static void reload_all_graphics(struct my_app *a, graphics_mode *mode)
 		if (window == NULL) {
 			continue;
 		}
-		
+
+		/* Tiles still queued would come from the old texture */
+		for (size_t j = 0; j < N_ELEMENTS(window->subwindows); j++) {
+			if (window->subwindows[j] != NULL) {
+				discard_quads(window->subwindows[j]);
+			}
+		}
 		free_graphics(&window->graphics);
 		memset(&window->graphics, 0, sizeof(window->graphics));
 		window->graphics.texture = NULL;
@@ -5605,6 +6083,7 @@ static bool reload_font(struct subwindow *subwindow,
 	coerce_rect_in_rect(&subwindow->sizing_rect,
 		&subwindow->window->inner_rect, min_w, min_h);
 
+	discard_quads(subwindow);
 	free_font(subwindow->font);
 	subwindow->font = new_font;
 
@@ -5649,6 +6128,7 @@ static void free_font(struct font *font)
 	if (font->cache.texture != NULL) {
 		SDL_DestroyTexture(font->cache.texture);
 	}
+	free_glyph_atlas(&font->cache.atlas);
 
 	mem_free(font);
 }
@@ -5667,12 +6147,23 @@ static void recreate_textures(struct my_app *a, bool all)
 			continue;
 		}
 
+		/*
+		 * Anything still queued for the subwindows refers to textures
+		 * about to be replaced; the terms are redrawn below anyway.
+		 */
+		for (j = 0; j < MAX_SUBWINDOWS; ++j) {
+			if (w->subwindows[j]) {
+				discard_quads(w->subwindows[j]);
+			}
+		}
+
 		/*
 		 * Recreate the dynamic texture used to cache the dialog font.
 		 */
 		if (w->dialog_font->cache.texture) {
 			SDL_DestroyTexture(w->dialog_font->cache.texture);
 			w->dialog_font->cache.texture = NULL;
+			free_glyph_atlas(&w->dialog_font->cache.atlas);
 			make_font_cache(w, w->dialog_font);
 		}
 
@@ -5724,6 +6215,7 @@ static void recreate_textures(struct my_app *a, bool all)
 			if (sw->font->cache.texture) {
 				SDL_DestroyTexture(sw->font->cache.texture);
 				sw->font->cache.texture = NULL;
+				free_glyph_atlas(&sw->font->cache.atlas);
 				make_font_cache(w, sw->font);
 			}
 		}
@@ -6550,6 +7042,8 @@ static struct subwindow *transfer_subwindow(struct sdlpui_window *window,
 	assert(subwindow->inited);
 	assert(subwindow->loaded);
 
+	/* Its textures and font are remade for the new window's renderer */
+	discard_quads(subwindow);
 	detach_subwindow_from_window(subwindow->window, subwindow);
 	if (subwindow->window != window) {
 		int minw, minh;
@@ -6936,6 +7430,7 @@ static void free_subwindow_config(struct subwindow_config *config)
 
 static void free_subwindow(struct subwindow *subwindow)
 {
+	free_quads(subwindow);
 	free_font(subwindow->font);
 	subwindow->font = NULL;
 	if (subwindow->texture != NULL) {
@@ -6963,6 +7458,10 @@ static void free_window(struct sdlpui_window *window)
 {
 	assert(window->loaded);
 
+	if (window->app->print_sdl_details) {
+		log_frame_stats(window);
+	}
+
 	while (window->d_head) {
 		sdlpui_popdown_dialog(window->d_head, window, SDL_FALSE);
 	}
@@ -6999,6 +7498,14 @@ static void free_window(struct sdlpui_window *window)
 
 	free_graphics(&window->graphics);
 
+#ifdef USE_QUAD_GEOMETRY
+	mem_free(window->vertices);
+	window->vertices = NULL;
+	mem_free(window->indices);
+	window->indices = NULL;
+	window->geometry_size = 0;
+#endif
+
 	if (window->renderer != NULL) {
 		SDL_DestroyRenderer(window->renderer);
 		window->renderer = NULL;
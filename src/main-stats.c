@@ -40,10 +40,16 @@
 #include "player-util.h"
 #include "project.h"
 #include "stats/db.h"
+#include "stats/records.h"
 #include "stats/structs.h"
 #include "store.h"
 #include <stddef.h>
 #include <time.h>
+#ifdef UNIX
+#include <errno.h>
+#include <poll.h>
+#include <sys/wait.h>
+#endif
 
 #define OBJ_FEEL_MAX	 11
 #define MON_FEEL_MAX 	 10
@@ -138,6 +144,15 @@ static int convert_to_consumables_index(int i0);
 static int randarts = 0;
 static int no_selling = 0;
 static uint32_t num_runs = 1;
+static uint32_t num_workers = 1;
+static uint32_t master_seed;
+static bool seed_given = false;
+static bool resume = false;
+static uint32_t replay_run = 0;
+static const char *records_path = NULL;
+static const char *convert_path = NULL;
+static uint32_t level_record[SREC_MAX];
+static bool (*record_sink)(const uint32_t *) = stats_records_add;
 static bool quiet = false;
 static int nextkey = 0;
 static int running_stats = 0;
@@ -474,17 +489,39 @@ static void generate_player_for_stats(void)
 	player->history = get_history(player->race->history);
 }
 
-static void initialize_character(void)
+/**
+ * Derive the seed for a run from the master seed and the run number.  The
+ * bits are mixed so that jobs with nearby master seeds don't share runs.
+ */
+static uint32_t stats_run_seed(uint32_t run)
 {
-	uint32_t seed;
+	uint32_t h = master_seed ^ (run * 0x9e3779b9U);
+
+	h ^= h >> 16;
+	h *= 0x85ebca6bU;
+	h ^= h >> 13;
+	h *= 0xc2b2ae35U;
+	h ^= h >> 16;
+	return h;
+}
+
+/**
+ * Set up the character for a run.  Each run is seeded from its number so a
+ * run gives the same result whichever worker does it, and can be replayed.
+ */
+static void initialize_character(uint32_t run)
+{
+	uint32_t seed = stats_run_seed(run);
+	int i;
 
 	if (!quiet) {
 		printf(" [I  ]\b\b\b\b\b\b");
 		fflush(stdout);
 	}
 
-	seed = (time(NULL));
+	/* Rand_state_init() carries on from the current index; start afresh */
 	Rand_quick = false;
+	state_i = 0;
 	Rand_state_init(seed);
 
 	player_init(player);
@@ -497,6 +534,9 @@ static void initialize_character(void)
 		do_randart(seed_randart, false);
 	}
 
+	/* store_shuffle() picks an owner other than the last run's */
+	for (i = 0; i < z_info->store_max; i++)
+		stores[i].owner = NULL;
 	store_reset();
 	flavor_init();
 	player->upkeep->playing = true;
@@ -515,11 +555,15 @@ static void kill_all_monsters(int level)
 		if (!mon->race) continue;
 
 		level_data[level].monsters[mon->race->ridx]++;
+		level_record[SREC_MONSTERS]++;
 
 		monster_death(mon, player, true);
 
-		if (monster_is_unique(mon))
+		if (monster_is_unique(mon)) {
+			level_record[SREC_UNIQUES]++;
 			mon->race->max_num = 0;
+			invalidate_mon_num_tables();
+		}
 	}
 }
 
@@ -538,6 +582,7 @@ static void unkill_uniques(void)
 		if (rf_has(race->flags, RF_UNIQUE))
 			race->max_num = 1;
 	}
+	invalidate_mon_num_tables();
 }
 
 static void reset_artifacts(void)
@@ -595,13 +640,19 @@ static void log_all_objects(int level)
 					continue;
 				}
 
+				level_record[SREC_OBJECTS]++;
+
 				/* Capture gold amounts */
-				if (tval_is_money(obj))
+				if (tval_is_money(obj)) {
 					level_data[level].gold[obj->origin] += obj->pval;
+					level_record[SREC_GOLD] += obj->pval;
+				}
 
 				/* Capture artifact drops */
-				if (obj->artifact)
+				if (obj->artifact) {
 					level_data[level].artifacts[obj->origin][obj->artifact->aidx]++;
+					level_record[SREC_ARTIFACTS]++;
+				}
 
 				/* Capture kind details */
 				if (tval_has_variable_power(obj)) {
@@ -609,14 +660,17 @@ static void log_all_objects(int level)
 						= &level_data[level].wearables[obj->origin][wearables_index[obj->kind->kidx]];
 
 					w->count++;
+					level_record[SREC_WEARABLES]++;
 					w->dice[MIN(obj->dd, TOP_DICE - 1)][MIN(obj->ds, TOP_SIDES - 1)]++;
 					w->ac[MIN(MAX(obj->ac + obj->to_a, 0), TOP_AC - 1)]++;
 					w->hit[MIN(MAX(obj->to_h, 0), TOP_PLUS - 1)]++;
 					w->dam[MIN(MAX(obj->to_d, 0), TOP_PLUS - 1)]++;
 
 					/* Capture egos */
-					if (obj->ego)
+					if (obj->ego) {
 						w->egos[obj->ego->eidx]++;
+						level_record[SREC_EGOS]++;
+					}
 					/* Capture object flags */
 					for (i = of_next(obj->flags, FLAG_START); i != FLAG_END;
 							i = of_next(obj->flags, i + 1))
@@ -628,6 +682,7 @@ static void log_all_objects(int level)
 					}
 				} else {
 					level_data[level].consumables[obj->origin][consumables_index[obj->kind->kidx]]++;
+					level_record[SREC_CONSUMABLES]++;
 				}
 
 				obj = obj->next;
@@ -636,7 +691,7 @@ static void log_all_objects(int level)
 	}
 }
 
-static void descend_dungeon(void)
+static void descend_dungeon(uint32_t run)
 {
 	int level;
 	uint16_t obj_f, mon_f;
@@ -659,6 +714,11 @@ static void descend_dungeon(void)
 		dungeon_change_level(player, level);
 		prepare_next_level(player);
 
+		memset(level_record, 0, sizeof(level_record));
+		level_record[SREC_RUN] = run;
+		level_record[SREC_LEVEL] = level;
+		level_record[SREC_FEELING] = cave->feeling;
+
 		/* Store level feelings */
 		obj_f = cave->feeling / 10;
 		mon_f = cave->feeling - (10 * obj_f);
@@ -668,6 +728,9 @@ static void descend_dungeon(void)
 		log_all_objects(level);
 		/* Besides killing, also gathers counts. */
 		kill_all_monsters(level);
+
+		if (records_path && !record_sink(level_record))
+			quit("Couldn't write level record!");
 	}
 }
 
@@ -1229,6 +1292,8 @@ static int stats_dump_info(void)
  *     wearables_egos
  *     wearables_flags
  *     wearables_mods
+ * Per-level tables, only filled by loading a file of level records:
+ *     level_records -- one row per level per run, see stats/records.h
  */
 static bool stats_prep_db(void)
 {
@@ -1322,6 +1387,9 @@ static bool stats_prep_db(void)
 		if (err) return false;
 	}
 
+	err = stats_records_prep_db();
+	if (err) return false;
+
 	err = stats_dump_info();
 	if (err) return false;
 
@@ -1636,6 +1704,12 @@ static int stats_write_db(uint32_t run)
 	err = stats_db_exec(sql_buf);
 	if (err) return err;
 
+	strnfmt(sql_buf, 256,
+		"INSERT OR REPLACE INTO metadata VALUES('seed', %u);",
+		master_seed);
+	err = stats_db_exec(sql_buf);
+	if (err) return err;
+
 	for (i = 0; i < (int)N_ELEMENTS(level_introspection); ++i) {
 		err = (*level_introspection[i].inserter)(
 			&level_introspection[i]);
@@ -1694,6 +1768,12 @@ static void progress_bar(uint32_t run, time_t start) {
 
 static void stats_cleanup_angband_run(void)
 {
+	/*
+	 * Forget stored levels, such as the town, so the next run builds its
+	 * own rather than depending on what came before.
+	 */
+	chunk_list_free();
+
 	if (character_dungeon) {
 		wipe_mon_list(cave, player);
 		if (player->cave) {
@@ -1710,9 +1790,537 @@ static void stats_cleanup_angband_run(void)
 	player->history = NULL;
 }
 
-static errr run_stats(void)
+/**
+ * Make one run through the dungeon, starting with a fresh character.
+ */
+static void stats_do_run(uint32_t run, const struct artifact *a_info_save,
+		const struct artifact_upkeep *aup_info_save)
+{
+	unsigned int i;
+
+	if (randarts) {
+		for (i = 0; i < z_info->a_max; i++) {
+			memcpy(&a_info[i], &a_info_save[i],
+				sizeof(struct artifact));
+			memcpy(&aup_info[i], &aup_info_save[i],
+				sizeof(struct artifact_upkeep));
+		}
+	}
+
+	initialize_character(run);
+	unkill_uniques();
+	reset_artifacts();
+	descend_dungeon(run);
+	stats_cleanup_angband_run();
+}
+
+/**
+ * Walk every counter in level_data in a fixed order, passing each array to
+ * one of the handlers.  The layout only depends on the game data, so a
+ * worker and its parent, or a checkpoint and the job resuming from it,
+ * walk the same sequence.
+ */
+static bool stats_walk_data(void *ctx,
+		bool (*u32_handler)(void *, uint32_t *, size_t),
+		bool (*ll_handler)(void *, long long *, size_t))
+{
+	int i, j, k, l;
+
+	for (i = 0; i < LEVEL_MAX; i++) {
+		struct level_data *ld = &level_data[i];
+
+		if (!u32_handler(ctx, ld->monsters, z_info->r_max)
+				|| !u32_handler(ctx, ld->obj_feelings, OBJ_FEEL_MAX)
+				|| !u32_handler(ctx, ld->mon_feelings, MON_FEEL_MAX)
+				|| !ll_handler(ctx, ld->gold, ORIGIN_STATS))
+			return false;
+		for (j = 0; j < ORIGIN_STATS; j++) {
+			if (!u32_handler(ctx, ld->artifacts[j], z_info->a_max)
+					|| !u32_handler(ctx, ld->consumables[j],
+					consumable_count + 1))
+				return false;
+			for (k = 0; k < wearable_count + 1; k++) {
+				struct wearables_data *w = &ld->wearables[j][k];
+
+				if (!u32_handler(ctx, &w->count, 1)
+						|| !u32_handler(ctx, &w->dice[0][0],
+						TOP_DICE * TOP_SIDES)
+						|| !u32_handler(ctx, w->ac, TOP_AC)
+						|| !u32_handler(ctx, w->hit, TOP_PLUS)
+						|| !u32_handler(ctx, w->dam, TOP_PLUS)
+						|| !u32_handler(ctx, w->egos,
+						z_info->e_max)
+						|| !u32_handler(ctx, w->flags, OF_MAX))
+					return false;
+				for (l = 0; l < TOP_MOD; l++) {
+					if (!u32_handler(ctx, w->modifiers[l],
+							OBJ_MOD_MAX + 1))
+						return false;
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+static bool stats_clear_u32(void *ctx, uint32_t *p, size_t n)
+{
+	memset(p, 0, n * sizeof(*p));
+	return true;
+}
+
+static bool stats_clear_ll(void *ctx, long long *p, size_t n)
+{
+	memset(p, 0, n * sizeof(*p));
+	return true;
+}
+
+/**
+ * ------------------------------------------------------------------------
+ * Checkpoints
+ *
+ * A checkpoint holds the job's settings, the number of runs completed and
+ * the raw counters, so an interrupted job can carry on exactly where it
+ * left off.  The counts of the things the counters are indexed by are
+ * stored as well, to catch a checkpoint from different game data.
+ * ------------------------------------------------------------------------ */
+
+#define STATS_CHECKPOINT_MAGIC		0x53544b43
+#define STATS_CHECKPOINT_VERSION	1
+
+enum {
+	CKPT_MAGIC,
+	CKPT_VERSION,
+	CKPT_SEED,
+	CKPT_DONE,
+	CKPT_RUNS,
+	CKPT_RANDARTS,
+	CKPT_NO_SELLING,
+	CKPT_R_MAX,		/* Layout of the counters from here on */
+	CKPT_A_MAX,
+	CKPT_E_MAX,
+	CKPT_CONSUMABLES,
+	CKPT_WEARABLES,
+	CKPT_OF_MAX,
+	CKPT_MOD_MAX,
+	CKPT_ORIGINS,
+	CKPT_LEVELS,
+	CKPT_MAX
+};
+
+static void stats_checkpoint_path(char *buf, size_t len)
+{
+	path_build(buf, len, ANGBAND_DIR_STATS, "checkpoint");
+}
+
+static bool stats_save_u32(void *ctx, uint32_t *p, size_t n)
+{
+	return file_write((ang_file *)ctx, (const char *)p, n * sizeof(*p));
+}
+
+static bool stats_save_ll(void *ctx, long long *p, size_t n)
+{
+	return file_write((ang_file *)ctx, (const char *)p, n * sizeof(*p));
+}
+
+static bool stats_load_u32(void *ctx, uint32_t *p, size_t n)
+{
+	int len = (int)(n * sizeof(*p));
+
+	return file_read((ang_file *)ctx, (char *)p, len) == len;
+}
+
+static bool stats_load_ll(void *ctx, long long *p, size_t n)
+{
+	int len = (int)(n * sizeof(*p));
+
+	return file_read((ang_file *)ctx, (char *)p, len) == len;
+}
+
+static void stats_fill_header(uint32_t *header, uint32_t done)
+{
+	header[CKPT_MAGIC] = STATS_CHECKPOINT_MAGIC;
+	header[CKPT_VERSION] = STATS_CHECKPOINT_VERSION;
+	header[CKPT_SEED] = master_seed;
+	header[CKPT_DONE] = done;
+	header[CKPT_RUNS] = num_runs;
+	header[CKPT_RANDARTS] = randarts;
+	header[CKPT_NO_SELLING] = no_selling;
+	header[CKPT_R_MAX] = z_info->r_max;
+	header[CKPT_A_MAX] = z_info->a_max;
+	header[CKPT_E_MAX] = z_info->e_max;
+	header[CKPT_CONSUMABLES] = consumable_count;
+	header[CKPT_WEARABLES] = wearable_count;
+	header[CKPT_OF_MAX] = OF_MAX;
+	header[CKPT_MOD_MAX] = OBJ_MOD_MAX;
+	header[CKPT_ORIGINS] = ORIGIN_STATS;
+	header[CKPT_LEVELS] = LEVEL_MAX;
+}
+
+/**
+ * Save the counters after the first done runs.  The new checkpoint is
+ * written beside the old one and only replaces it once complete.
+ */
+static void stats_write_checkpoint(uint32_t done)
+{
+	char path[1024], new_path[1024];
+	uint32_t header[CKPT_MAX];
+	ang_file *f;
+	bool ok;
+
+	stats_checkpoint_path(path, sizeof(path));
+	strnfmt(new_path, sizeof(new_path), "%s.new", path);
+
+	f = file_open(new_path, MODE_WRITE, FTYPE_RAW);
+	if (!f) quit_fmt("Couldn't create checkpoint '%s'!", new_path);
+	stats_fill_header(header, done);
+	ok = stats_save_u32(f, header, CKPT_MAX)
+		&& stats_walk_data(f, stats_save_u32, stats_save_ll);
+	if (!file_close(f) || !ok)
+		quit_fmt("Couldn't write checkpoint '%s'!", new_path);
+
+	if (file_exists(path) && !file_delete(path))
+		quit_fmt("Couldn't replace checkpoint '%s'!", path);
+	if (!file_move(new_path, path))
+		quit_fmt("Couldn't replace checkpoint '%s'!", path);
+}
+
+/**
+ * Read the checkpoint, taking the job's settings from it, and the counters
+ * too if load_data is set.  Returns the number of runs it covers.
+ */
+static uint32_t stats_read_checkpoint(bool load_data)
+{
+	char path[1024];
+	uint32_t header[CKPT_MAX], expect[CKPT_MAX];
+	ang_file *f;
+	int i;
+
+	stats_checkpoint_path(path, sizeof(path));
+	f = file_open(path, MODE_READ, FTYPE_RAW);
+	if (!f) quit_fmt("Couldn't open checkpoint '%s'!", path);
+
+	if (!stats_load_u32(f, header, CKPT_MAX)
+			|| header[CKPT_MAGIC] != STATS_CHECKPOINT_MAGIC
+			|| header[CKPT_VERSION] != STATS_CHECKPOINT_VERSION)
+		quit_fmt("'%s' is not a stats checkpoint!", path);
+
+	stats_fill_header(expect, 0);
+	for (i = CKPT_R_MAX; i < CKPT_MAX; i++) {
+		if (header[i] != expect[i])
+			quit_fmt("Checkpoint '%s' is from different game data!",
+				path);
+	}
+
+	master_seed = header[CKPT_SEED];
+	num_runs = header[CKPT_RUNS];
+	randarts = header[CKPT_RANDARTS];
+	no_selling = header[CKPT_NO_SELLING];
+
+	if (load_data && !stats_walk_data(f, stats_load_u32, stats_load_ll))
+		quit_fmt("Checkpoint '%s' is truncated!", path);
+	file_close(f);
+
+	return header[CKPT_DONE];
+}
+
+#ifdef UNIX
+
+/*
+ * Messages from a worker: one byte per finished run, or a byte and a level
+ * record, then a byte and the counters
+ */
+#define STATS_WORKER_RUN	'r'
+#define STATS_WORKER_RECORD	'l'
+#define STATS_WORKER_DATA	'd'
+
+static int worker_fd = -1;
+
+static bool stats_write_all(int fd, const void *buf, size_t len)
+{
+	const char *p = buf;
+
+	while (len > 0) {
+		ssize_t n = write(fd, p, len);
+
+		if (n < 0) {
+			if (errno == EINTR) continue;
+			return false;
+		}
+		p += n;
+		len -= n;
+	}
+	return true;
+}
+
+static bool stats_read_all(int fd, void *buf, size_t len)
+{
+	char *p = buf;
+
+	while (len > 0) {
+		ssize_t n = read(fd, p, len);
+
+		if (n < 0) {
+			if (errno == EINTR) continue;
+			return false;
+		}
+		if (n == 0) return false;
+		p += n;
+		len -= n;
+	}
+	return true;
+}
+
+static bool stats_send_u32(void *ctx, uint32_t *p, size_t n)
+{
+	return stats_write_all(*(int *)ctx, p, n * sizeof(*p));
+}
+
+static bool stats_send_ll(void *ctx, long long *p, size_t n)
+{
+	return stats_write_all(*(int *)ctx, p, n * sizeof(*p));
+}
+
+/**
+ * Add the counts a worker sends to ours, in blocks so large arrays don't
+ * need a buffer as big as themselves.
+ */
+static bool stats_merge_u32(void *ctx, uint32_t *p, size_t n)
 {
+	uint32_t buf[1024];
+
+	while (n > 0) {
+		size_t i, m = MIN(n, N_ELEMENTS(buf));
+
+		if (!stats_read_all(*(int *)ctx, buf, m * sizeof(*buf)))
+			return false;
+		for (i = 0; i < m; i++) p[i] += buf[i];
+		p += m;
+		n -= m;
+	}
+	return true;
+}
+
+static bool stats_merge_ll(void *ctx, long long *p, size_t n)
+{
+	long long buf[ORIGIN_STATS];
+
+	while (n > 0) {
+		size_t i, m = MIN(n, N_ELEMENTS(buf));
+
+		if (!stats_read_all(*(int *)ctx, buf, m * sizeof(*buf)))
+			return false;
+		for (i = 0; i < m; i++) p[i] += buf[i];
+		p += m;
+		n -= m;
+	}
+	return true;
+}
+
+/**
+ * Pass a level record to the parent, which writes them all to the one file
+ */
+static bool stats_send_record(const uint32_t *record)
+{
+	const char msg = STATS_WORKER_RECORD;
+
+	if (!stats_write_all(worker_fd, &msg, 1)
+			|| !stats_write_all(worker_fd, record,
+			SREC_MAX * sizeof(*record)))
+		_exit(1);
+	return true;
+}
+
+/**
+ * Body of a worker process:  make runs first to last, reporting each one
+ * as it finishes, then send the counters back and exit.  Never returns.
+ */
+static void stats_worker(int fd, uint32_t first, uint32_t last,
+		const struct artifact *a_info_save,
+		const struct artifact_upkeep *aup_info_save)
+{
+	const char run_msg = STATS_WORKER_RUN, data_msg = STATS_WORKER_DATA;
 	uint32_t run;
+
+	/* Only the parent reports progress and writes records */
+	quiet = true;
+	worker_fd = fd;
+	record_sink = stats_send_record;
+
+	/* Count from zero so the parent can add our counters to its own */
+	stats_walk_data(NULL, stats_clear_u32, stats_clear_ll);
+
+	for (run = first; run <= last; run++) {
+		stats_do_run(run, a_info_save, aup_info_save);
+		if (!stats_write_all(fd, &run_msg, 1)) _exit(1);
+	}
+
+	if (!stats_write_all(fd, &data_msg, 1)
+			|| !stats_walk_data(&fd, stats_send_u32, stats_send_ll))
+		_exit(1);
+	close(fd);
+
+	/* Leave the database and the rest of the shared state alone */
+	_exit(0);
+}
+
+/**
+ * Split runs first to last between up to num_workers child processes and
+ * add up what they find.  Each worker gets a contiguous block of run
+ * numbers, and so of seeds, so the totals match those from doing the runs
+ * one after another.
+ */
+static void stats_run_workers(uint32_t first, uint32_t last, time_t start,
+		const struct artifact *a_info_save,
+		const struct artifact_upkeep *aup_info_save)
+{
+	uint32_t n = last - first + 1;
+	uint32_t workers = MIN(num_workers, n);
+	struct pollfd *fds = mem_zalloc(workers * sizeof(*fds));
+	pid_t *pids = mem_zalloc(workers * sizeof(*pids));
+	uint32_t w, done = first - 1, active = workers;
+
+	/* Don't hand pending output to the children */
+	fflush(stdout);
+
+	for (w = 0; w < workers; w++) {
+		uint32_t from = first + (uint32_t)(((uint64_t)n * w) / workers);
+		uint32_t to = first - 1
+			+ (uint32_t)(((uint64_t)n * (w + 1)) / workers);
+		int pipefd[2];
+
+		if (pipe(pipefd) != 0) quit("Couldn't create worker pipe!");
+		pids[w] = fork();
+		if (pids[w] < 0) quit("Couldn't start worker!");
+		if (pids[w] == 0) {
+			uint32_t v;
+
+			/* Don't hold the other workers' pipes open */
+			for (v = 0; v < w; v++) close(fds[v].fd);
+			close(pipefd[0]);
+			stats_worker(pipefd[1], from, to, a_info_save,
+				aup_info_save);
+		}
+		close(pipefd[1]);
+		fds[w].fd = pipefd[0];
+		fds[w].events = POLLIN;
+	}
+
+	while (active > 0) {
+		if (poll(fds, workers, -1) < 0) {
+			if (errno == EINTR) continue;
+			quit("Problems waiting for workers!");
+		}
+
+		for (w = 0; w < workers; w++) {
+			char msg;
+			int status;
+
+			if (fds[w].fd < 0 || !fds[w].revents) continue;
+			if (!stats_read_all(fds[w].fd, &msg, 1))
+				quit_fmt("Worker %d stopped unexpectedly!", w + 1);
+
+			if (msg == STATS_WORKER_RECORD) {
+				uint32_t record[SREC_MAX];
+
+				if (!stats_read_all(fds[w].fd, record,
+						sizeof(record)))
+					quit_fmt("Bad data from worker %d!", w + 1);
+				if (!stats_records_add(record))
+					quit("Couldn't write level record!");
+				continue;
+			}
+
+			if (msg == STATS_WORKER_RUN) {
+				done++;
+				if (!quiet) {
+					progress_bar(done, start);
+				} else if (done % 1000 == 0) {
+					printf("Finished %d runs.\n", done);
+					fflush(stdout);
+				}
+				continue;
+			}
+
+			if (msg != STATS_WORKER_DATA || !stats_walk_data(&fds[w].fd,
+					stats_merge_u32, stats_merge_ll))
+				quit_fmt("Bad data from worker %d!", w + 1);
+			close(fds[w].fd);
+			fds[w].fd = -1;
+			active--;
+
+			if (waitpid(pids[w], &status, 0) < 0
+					|| !WIFEXITED(status)
+					|| WEXITSTATUS(status) != 0)
+				quit_fmt("Worker %d failed!", w + 1);
+		}
+	}
+
+	mem_free(pids);
+	mem_free(fds);
+}
+
+#endif /* UNIX */
+
+/**
+ * Make runs first to last, in worker processes if asked for.
+ */
+static void stats_run_batch(uint32_t first, uint32_t last, time_t start,
+		const struct artifact *a_info_save,
+		const struct artifact_upkeep *aup_info_save)
+{
+	uint32_t run;
+
+#ifdef UNIX
+	if (num_workers > 1 && last > first) {
+		stats_run_workers(first, last, start, a_info_save,
+			aup_info_save);
+		return;
+	}
+#endif
+
+	for (run = first; run <= last; run++) {
+		if (!quiet) progress_bar(run - 1, start);
+
+		stats_do_run(run, a_info_save, aup_info_save);
+
+		if (quiet && run % 1000 == 0) {
+			printf("Finished %d runs.\n", run);
+			fflush(stdout);
+		}
+	}
+}
+
+/**
+ * Load a file of level records into a new database, instead of making runs
+ */
+static void convert_records(void)
+{
+	bool status;
+
+	if (!quiet) printf("Creating the database and dumping info...\n");
+	if (!stats_prep_db()) quit("Couldn't prepare database!");
+
+	if (!quiet) {
+		printf("Loading level records from '%s'...\n", convert_path);
+		fflush(stdout);
+	}
+	status = stats_records_load(convert_path);
+	stats_db_close();
+	if (!status)
+		quit_fmt("Couldn't load level records from '%s'!", convert_path);
+
+	string_free(ANGBAND_DIR_STATS);
+	cleanup_angband();
+	if (!quiet) printf("Done!\n");
+	quit(NULL);
+	exit(0);
+}
+
+static errr run_stats(void)
+{
+	uint32_t first = 1, last;
 	struct artifact *a_info_save = NULL;
 	struct artifact_upkeep *aup_info_save = NULL;
 	unsigned int i;
@@ -1722,8 +2330,21 @@ static errr run_stats(void)
 	time_t start;
 
 	prep_output_dir();
+	if (convert_path) convert_records();
 	create_indices();
 	alloc_memory();
+
+	/* Pick up the seed of a job to replay a run from, or carry one on */
+	if (replay_run) {
+		if (!seed_given) stats_read_checkpoint(false);
+		first = replay_run;
+		num_runs = replay_run;
+	} else if (resume) {
+		first = stats_read_checkpoint(true) + 1;
+	} else if (!seed_given) {
+		master_seed = (uint32_t)time(NULL);
+	}
+
 	if (randarts) {
 		a_info_save = mem_zalloc(z_info->a_max * sizeof(struct artifact));
 		aup_info_save = mem_zalloc(z_info->a_max
@@ -1742,55 +2363,63 @@ static errr run_stats(void)
 	status = stats_prep_db();
 	if (!status) quit("Couldn't prepare database!");
 
+	/*
+	 * Records from after the last checkpoint, or of the run being replayed,
+	 * are replaced when loaded, so both add to what is there
+	 */
+	if (records_path && !stats_records_open(records_path,
+			resume || replay_run))
+		quit_fmt("Couldn't open '%s' for level records!", records_path);
+
 	if (!quiet) {
-		printf("Beginning %d runs...\n", num_runs);
+		if (replay_run) {
+			printf("Replaying run %d with seed %u...\n", replay_run,
+				master_seed);
+		} else if (first > 1) {
+			printf("Resuming at run %d of %d with seed %u...\n",
+				first, num_runs, master_seed);
+		} else {
+			printf("Beginning %d runs with seed %u...\n", num_runs,
+				master_seed);
+		}
 		fflush(stdout);
 	}
 
 	start = time(NULL);
-	for (run = 1; run <= num_runs; run++) {
-		if (!quiet) progress_bar(run - 1, start);
-
-		if (randarts) {
-			for (i = 0; i < z_info->a_max; i++) {
-				memcpy(&a_info[i], &a_info_save[i],
-					sizeof(struct artifact));
-				memcpy(&aup_info[i], &aup_info_save[i],
-					sizeof(struct artifact_upkeep));
-			}
-		}
-
-		initialize_character();
-		unkill_uniques();
-		reset_artifacts();
-		descend_dungeon();
-		stats_cleanup_angband_run();
-
-		/* Checkpoint every so many runs */
-		if (run % RUNS_PER_CHECKPOINT == 0) {
-			err = stats_write_db(run);
+	if (replay_run) {
+		/* Just the one run, leaving the checkpoint alone */
+		stats_do_run(replay_run, a_info_save, aup_info_save);
+	} else {
+		for (; first <= num_runs; first = last + 1) {
+			/* Checkpoint every so many runs */
+			last = MIN(num_runs, ((first - 1) / RUNS_PER_CHECKPOINT + 1)
+				* RUNS_PER_CHECKPOINT);
+			stats_run_batch(first, last, start, a_info_save,
+				aup_info_save);
+			if (!stats_records_sync())
+				quit("Couldn't write level records!");
+			stats_write_checkpoint(last);
+			if (last == num_runs) break;
+
+			err = stats_write_db(last);
 			if (err) {
 				stats_db_close();
 				quit_fmt("Problems writing to database!  sqlite3 errno %d.",
 						 err);
 			}
 		}
-
-		if (quiet && run % 1000 == 0) {
-			printf("Finished %d runs.\n", run);
-			fflush(stdout);
-		}
 	}
 
 	if (!quiet) {
-		progress_bar(num_runs, start);
+		if (!replay_run) progress_bar(num_runs, start);
 		printf("\nSaving the data...\n");
 		fflush(stdout);
 	}
 
-	err = stats_write_db(run);
+	err = stats_write_db(replay_run ? 1 : num_runs);
 	stats_db_close();
 	if (err) quit_fmt("Problems writing to database!  sqlite3 errno %d.", err);
+	if (!stats_records_close()) quit("Couldn't write level records!");
 
 	if (randarts) {
 		mem_free(aup_info_save);
@@ -1925,17 +2554,29 @@ static void term_data_link(int i) {
 	angband_term[i] = t;
 }
 
-const char help_stats[] = "Stats mode, subopts -q(uiet) -r(andarts) -n(# of runs) -s(no selling)";
+const char help_stats[] = "Stats mode, subopts -q(uiet) -r(andarts) -n(# of runs) -j(# of workers) -s(no selling) --seed N --resume --replay-run N --records FILE --convert-records FILE";
 
 /**
  * Usage:
  *
- * angband -mstats -- [-q] [-r] [-nNNNN] [-s]
+ * angband -mstats -- [-q] [-r] [-nNNNN] [-jNN] [-s] [--seed N]
+ *                      [--resume] [--replay-run K] [--records FILE]
+ * angband -mstats -- [-q] --convert-records FILE
  *
  *   -q      Quiet mode (turn off progress messages)
  *   -r      Turn on randarts
  *   -nNNNN  Make NNNN runs through the dungeon (default: 1)
+ *   -jNN    Split the runs between NN worker processes (default: 1)
  *   -s      Turn on no-selling
+ *   --seed N        Derive the seed for each run from N (default: the time)
+ *   --resume        Carry on the job in the stats directory's checkpoint,
+ *                   with the seed, number of runs and options it was using
+ *   --replay-run K  Make only run K, with the seed from --seed or from the
+ *                   checkpoint, and leave the checkpoint alone
+ *   --records FILE  Also write a record for each level of each run to FILE,
+ *                   adding to it with --resume or --replay-run
+ *   --convert-records FILE  Load the records in FILE into the level_records
+ *                   table of a new database rather than making any runs
  */
 
 errr init_stats(int argc, char *argv[]) {
@@ -1955,6 +2596,35 @@ errr init_stats(int argc, char *argv[]) {
 			num_runs = atoi(&argv[i][2]);
 			continue;
 		}
+		if (streq(argv[i], "--seed") && i + 1 < argc) {
+			master_seed = strtoul(argv[++i], NULL, 0);
+			seed_given = true;
+			continue;
+		}
+		if (streq(argv[i], "--records") && i + 1 < argc) {
+			records_path = argv[++i];
+			continue;
+		}
+		if (streq(argv[i], "--convert-records") && i + 1 < argc) {
+			convert_path = argv[++i];
+			continue;
+		}
+		if (streq(argv[i], "--resume")) {
+			resume = true;
+			continue;
+		}
+		if (streq(argv[i], "--replay-run") && i + 1 < argc) {
+			int n = atoi(argv[++i]);
+
+			replay_run = (n > 0) ? n : 0;
+			continue;
+		}
+		if (prefix(argv[i], "-j")) {
+			int n = atoi(&argv[i][2]);
+
+			num_workers = (n > 1) ? n : 1;
+			continue;
+		}
 		if (prefix(argv[i], "-s")) {
 			no_selling = 1;
 			continue;
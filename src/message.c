@@ -36,9 +36,7 @@
 
 typedef struct _message_t
 {
-	char *str;
-	struct _message_t *newer;
-	struct _message_t *older;
+	uint32_t text;	/* Offset of the text in the text buffer */
 	uint16_t type;
 	uint16_t count;
 } message_t;
@@ -50,15 +48,28 @@ typedef struct _msgcolor_t
 	struct _msgcolor_t *next;
 } msgcolor_t;
 
+/**
+ * The messages are kept in a ring of max entries, the oldest at ring[first],
+ * so finding a message by age takes one step and dropping the oldest is free.
+ * Their text goes one after the other round a circular buffer, starting again
+ * at the beginning when it will not fit before the end; if the text of a new
+ * message would run into that of the oldest, the buffer is repacked, bigger
+ * if need be.
+ */
 typedef struct _msgqueue_t
 {
-	message_t *head;
-	message_t *tail;
+	message_t *ring;
 	msgcolor_t *colors;
+	uint32_t first;
 	uint32_t count;
 	uint32_t max;
+	char *text;
+	uint32_t text_size;
+	uint32_t text_end;	/* Just past the text of the newest message */
 } msgqueue_t;
 
+#define MESSAGE_TEXT_INIT	65536
+
 static msgqueue_t *messages = NULL;
 
 /**
@@ -73,6 +84,9 @@ void messages_init(void)
 {
 	messages = mem_zalloc(sizeof(msgqueue_t));
 	messages->max = 2048;
+	messages->ring = mem_zalloc(messages->max * sizeof(message_t));
+	messages->text_size = MESSAGE_TEXT_INIT;
+	messages->text = mem_alloc(messages->text_size);
 }
 
 /**
@@ -82,15 +96,9 @@ void messages_free(void)
 {
 	msgcolor_t *c = messages->colors;
 	msgcolor_t *nextc;
-	message_t *m = messages->head;
-	message_t *nextm;
-
-	while (m) {
-		nextm = m->older;
-		mem_free(m->str);
-		mem_free(m);
-		m = nextm;
-	}
+
+	mem_free(messages->ring);
+	mem_free(messages->text);
 
 	while (c) {
 		nextc = c->next;
@@ -114,66 +122,112 @@ uint16_t messages_num(void)
  * Functions for individual messages
  * ------------------------------------------------------------------------ */
 /**
- * Save a new message into the memory buffer, with text `str` and type `type`.
- * The type should be one of the MSG_ constants defined in message.h.
- *
- * The new message may not be saved if it is identical to the one saved before
- * it, in which case the "count" of the message will be increased instead.
- * This count can be fetched using the message_count() function.
+ * Returns the message of age `age`.
  */
-void message_add(const char *str, uint16_t type)
+static message_t *message_get(uint16_t age)
 {
-	message_t *m;
+	if (age >= messages->count) return NULL;
+	return &messages->ring[(messages->first + messages->count - 1 - age)
+		% messages->max];
+}
 
-	if (messages->head &&
-	    messages->head->type == type &&
-	    streq(messages->head->str, str) &&
-	    messages->head->count != (uint16_t)-1) {
-		messages->head->count++;
-		return;
-	}
+/**
+ * Copy the text of the messages to a new buffer of `size` bytes, oldest first
+ * from the start of the buffer.
+ */
+static void message_text_repack(uint32_t size)
+{
+	char *text = mem_alloc(size);
+	uint32_t end = 0, i;
 
-	m = mem_zalloc(sizeof(message_t));
-	m->str = string_make(str);
-	m->type = type;
-	m->count = 1;
-	m->older = messages->head;
+	for (i = 0; i < messages->count; i++) {
+		message_t *m = &messages->ring[(messages->first + i)
+			% messages->max];
+		uint32_t len = strlen(messages->text + m->text) + 1;
 
-	if (messages->head)
-		messages->head->newer = m;
+		memcpy(text + end, messages->text + m->text, len);
+		m->text = end;
+		end += len;
+	}
 
-	messages->head = m;
-	messages->count++;
+	mem_free(messages->text);
+	messages->text = text;
+	messages->text_size = size;
+	messages->text_end = end;
+}
 
-	if (!messages->tail)
-		messages->tail = m;
+/**
+ * Find room for `len` bytes of text after the text of the newest message,
+ * and return its offset.
+ */
+static uint32_t message_text_place(uint32_t len)
+{
+	uint32_t start, end = messages->text_end, live = 0, size, i;
 
-	if (messages->count > messages->max) {
-		message_t *old_tail = messages->tail;
+	if (!messages->count) return 0;
 
-		messages->tail = old_tail->newer;
-		messages->tail->older = NULL;
-		mem_free(old_tail->str);
-		mem_free(old_tail);
-		messages->count--;
+	/* Room between the newest and oldest text, or at the end or start */
+	start = message_get(messages->count - 1)->text;
+	if (message_get(0)->text >= start) {
+		if (end + len <= messages->text_size) return end;
+		if (len <= start) return 0;
+	} else if (end + len <= start) {
+		return end;
 	}
+
+	/* Pack the text up, making the buffer big enough to leave some spare */
+	for (i = 0; i < messages->count; i++)
+		live += strlen(messages->text + message_get(i)->text) + 1;
+	size = messages->text_size;
+	while (2 * (live + len) > size)
+		size *= 2;
+	message_text_repack(size);
+	return messages->text_end;
 }
 
 /**
- * Returns the message of age `age`.
+ * Save a new message into the memory buffer, with text `str` and type `type`.
+ * The type should be one of the MSG_ constants defined in message.h.
+ *
+ * The new message may not be saved if it is identical to the one saved before
+ * it, in which case the "count" of the message will be increased instead.
+ * This count can be fetched using the message_count() function.
  */
-static message_t *message_get(uint16_t age)
+void message_add(const char *str, uint16_t type)
 {
-	message_t *m = messages->head;
+	message_t *newest = message_get(0);
+	uint32_t len = strlen(str) + 1;
+	char *copy = NULL;
+
+	if (newest &&
+	    newest->type == type &&
+	    streq(messages->text + newest->text, str) &&
+	    newest->count != (uint16_t)-1) {
+		newest->count++;
+		return;
+	}
 
-	while (m && age) {
-		age--;
-		m = m->older;
+	/* The text may be that of an old message, which could be overwritten */
+	if (str >= messages->text && str < messages->text + messages->text_size)
+		str = copy = string_make(str);
+
+	/* Drop the oldest message if there is no room for another */
+	if (messages->count == messages->max) {
+		messages->first = (messages->first + 1) % messages->max;
+		messages->count--;
 	}
 
-	return m;
-}
+	newest = &messages->ring[(messages->first + messages->count)
+		% messages->max];
+	newest->text = message_text_place(len);
+	memcpy(messages->text + newest->text, str, len);
+	newest->type = type;
+	newest->count = 1;
 
+	messages->text_end = newest->text + len;
+	messages->count++;
+	string_free(copy);
+}
 
 /**
  * Returns the text of the message of age `age`.  The age of the most recently
@@ -185,7 +239,7 @@ static message_t *message_get(uint16_t age)
 const char *message_str(uint16_t age)
 {
 	message_t *m = message_get(age);
-	return (m ? m->str : "");
+	return (m ? messages->text + m->text : "");
 }
 
 /**
@@ -1092,6 +1092,8 @@ static void cleanup_mon_base(void)
 {
 	struct monster_base *rb, *next;
 
+	reset_monster_lookups();
+
 	rb = rb_info;
 	while (rb) {
 		next = rb->next;
@@ -1869,6 +1871,8 @@ static void cleanup_monster(void)
 {
 	int ridx;
 
+	reset_monster_lookups();
+
 	for (ridx = 0; ridx < z_info->r_max; ridx++) {
 		struct monster_race *r = &r_info[ridx];
 		struct monster_altmsg *am;
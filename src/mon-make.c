@@ -23,6 +23,7 @@
 #include "mon-group.h"
 #include "mon-lore.h"
 #include "mon-make.h"
+#include "mon-move.h"
 #include "mon-predicate.h"
 #include "mon-timed.h"
 #include "mon-util.h"
@@ -49,10 +50,54 @@
  * - prob3 is calculated by get_mon_num(), which checks whether universal
  *         restrictions apply (for example, unique monsters can only appear
  *         once on a given level); prob3 is always either prob2 or 0.
+ *
+ * Rather than being stored in the table, prob2 is kept as a filter listing
+ * the entries a restriction function allows, and prob3 as running totals in
+ * one cached table per generation depth for that filter, which lets
+ * get_mon_num() pick a race by binary search.  Filters for restrictions which
+ * only depend on a key (a summon type, pit profile or monster base) are kept
+ * for reuse; see get_mon_num_prep_cached().  The running totals are rebuilt
+ * as needed after a unique appears or goes away, or the season changes.
  * ------------------------------------------------------------------------ */
 static int16_t alloc_race_size;
 static struct alloc_entry *alloc_race_table;
 
+/**
+ * Running totals of prob3 for races up to one generation depth
+ */
+struct mon_num_table {
+	long *total;		/* Sum of prob3 up to and including each entry */
+	int num;		/* Number of entries up to the depth */
+	int current_level;	/* Level used for the FORCE_DEPTH check */
+	uint32_t stamp;		/* Value of mon_num_stamp when built */
+};
+
+/**
+ * Allocation table entries allowed by a restriction function
+ */
+struct mon_num_filter {
+	bool (*hook)(struct monster_race *race);
+	const void *key;	/* What else the function's result depends on */
+	int16_t *entries;	/* Allowed entries, sorted by depth */
+	int num;
+	struct mon_num_table *tables;	/* Running totals for each depth */
+	struct mon_num_filter *next;
+};
+
+/* Filters with no restriction, for the last uncached restriction, and kept */
+static struct mon_num_filter mon_num_all;
+static struct mon_num_filter mon_num_scratch;
+static struct mon_num_filter *mon_num_cache;
+
+/* The filter get_mon_num() uses */
+static struct mon_num_filter *mon_num_filter = &mon_num_all;
+
+static uint32_t mon_num_stamp = 1;
+
+/* Whether seasonal monsters are allowed, and when to check that again */
+static bool mon_num_seasonal;
+static time_t mon_num_season_check;
+
 /**
  * Initialize monster allocation info
  */
@@ -136,10 +181,68 @@ static void init_race_allocs(void) {
 	mem_free(num);
 }
 
+/**
+ * Free a filter's entries and running totals
+ */
+static void mon_num_filter_wipe(struct mon_num_filter *filter)
+{
+	int i;
+
+	if (filter->tables) {
+		for (i = 0; i < z_info->max_depth; i++)
+			mem_free(filter->tables[i].total);
+		mem_free(filter->tables);
+		filter->tables = NULL;
+	}
+	mem_free(filter->entries);
+	filter->entries = NULL;
+	filter->num = 0;
+}
+
+/**
+ * Fill in the entries a filter allows
+ */
+static void mon_num_filter_fill(struct mon_num_filter *filter)
+{
+	int i;
+
+	filter->entries = mem_alloc(MAX(alloc_race_size, 1) *
+		sizeof(*filter->entries));
+	filter->num = 0;
+	for (i = 0; i < alloc_race_size; i++) {
+		alloc_entry *entry = &alloc_race_table[i];
+
+		/* Check the restriction, if any */
+		if (!filter->hook || filter->hook(&r_info[entry->index]))
+			filter->entries[filter->num++] = i;
+	}
+}
+
 static void cleanup_race_allocs(void) {
+	struct mon_num_filter *filter = mon_num_cache;
+
+	while (filter) {
+		struct mon_num_filter *next = filter->next;
+		mon_num_filter_wipe(filter);
+		mem_free(filter);
+		filter = next;
+	}
+	mon_num_cache = NULL;
+	mon_num_filter_wipe(&mon_num_all);
+	mon_num_filter_wipe(&mon_num_scratch);
+	mon_num_filter = &mon_num_all;
 	mem_free(alloc_race_table);
 }
 
+/**
+ * Note that some race may have become allowed or disallowed by get_mon_num(),
+ * usually because a unique has appeared, died or been revived
+ */
+void invalidate_mon_num_tables(void)
+{
+	mon_num_stamp++;
+}
+
 
 /**
  * Apply a monster restriction function to the monster allocation table.
@@ -151,45 +254,175 @@ void get_mon_num_prep(bool (*get_mon_num_hook)(struct monster_race *race))
 {
 	int i;
 
+	/* No restriction */
+	if (!get_mon_num_hook) {
+		if (!mon_num_all.entries)
+			mon_num_filter_fill(&mon_num_all);
+		mon_num_filter = &mon_num_all;
+		return;
+	}
+
 	/* Scan the allocation table */
-	for (i = 0; i < alloc_race_size; i++) {
-		alloc_entry *entry = &alloc_race_table[i];
+	mem_free(mon_num_scratch.entries);
+	mon_num_scratch.hook = get_mon_num_hook;
+	mon_num_filter_fill(&mon_num_scratch);
+
+	/* Old running totals are no use */
+	if (mon_num_scratch.tables) {
+		for (i = 0; i < z_info->max_depth; i++)
+			mon_num_scratch.tables[i].stamp = 0;
+	}
+	mon_num_filter = &mon_num_scratch;
+}
 
-		/* Check the restriction, if any */
-		if (!get_mon_num_hook || (*get_mon_num_hook)(&r_info[entry->index])) {
-			/* Accept this monster */
-			entry->prob2 = entry->prob1;
+/**
+ * Apply a monster restriction function whose result only depends on the race
+ * and `key`, reusing the allowed races from the last time this function and
+ * key were used.
+ */
+void get_mon_num_prep_cached(bool (*get_mon_num_hook)(struct monster_race *race),
+		const void *key)
+{
+	struct mon_num_filter *filter;
 
-		} else {
-			/* Do not use this monster */
-			entry->prob2 = 0;
-		}
+	for (filter = mon_num_cache; filter; filter = filter->next) {
+		if (filter->hook == get_mon_num_hook && filter->key == key) break;
+	}
+
+	/* Scan the allocation table the first time only */
+	if (!filter) {
+		filter = mem_zalloc(sizeof(*filter));
+		filter->hook = get_mon_num_hook;
+		filter->key = key;
+		mon_num_filter_fill(filter);
+		filter->next = mon_num_cache;
+		mon_num_cache = filter;
+	}
+	mon_num_filter = filter;
+}
+
+/**
+ * Check whether seasonal monsters are allowed, looking at the date at most
+ * once a day
+ */
+static void update_mon_num_season(void)
+{
+	time_t cur_time = time(NULL);
+	struct tm *date;
+	bool seasonal;
+
+	if (mon_num_season_check && cur_time < mon_num_season_check
+			&& cur_time >= mon_num_season_check - 24 * 60 * 60)
+		return;
+
+	/* Check again at midnight */
+	date = localtime(&cur_time);
+	mon_num_season_check = cur_time + 24 * 60 * 60 - (date->tm_hour * 60 * 60
+		+ date->tm_min * 60 + date->tm_sec);
+
+	/* Seasonal monsters only at Christmas */
+	seasonal = date->tm_mon == 11 && date->tm_mday >= 24
+		&& date->tm_mday <= 26;
+	if (seasonal != mon_num_seasonal) {
+		mon_num_seasonal = seasonal;
+		invalidate_mon_num_tables();
 	}
 }
 
 /**
- * Helper function for get_mon_num(). Scans the prepared monster allocation
- * table and picks a random monster. Returns the index of a monster in
- * `table`.
+ * Get the running totals for the current filter at a given depth, building
+ * them if necessary.
+ *
+ * Races are only allowed if they are not town monsters in the dungeon, are
+ * not seasonal outside the season, are not uniques which are already around
+ * or dead, and are not FORCE_DEPTH monsters out of depth.
  */
-static struct monster_race *get_mon_race_aux(long total,
-											 const alloc_entry *table)
+static struct mon_num_table *get_mon_num_table(int generated_level,
+		int current_level)
 {
+	struct mon_num_filter *filter = mon_num_filter;
+	struct mon_num_table *table;
+	long total = 0;
 	int i;
 
-	/* Pick a monster */
-	long value = randint0(total);
+	/* Races are never deeper than the deepest level */
+	generated_level = MIN(generated_level, z_info->max_depth - 1);
+
+	/* The FORCE_DEPTH check only matters for out of depth races */
+	current_level = MIN(current_level, generated_level);
+
+	if (!filter->entries)
+		mon_num_filter_fill(filter);
+	if (!filter->tables)
+		filter->tables = mem_zalloc(z_info->max_depth *
+			sizeof(*filter->tables));
+	table = &filter->tables[generated_level];
+	if (table->total && table->stamp == mon_num_stamp
+			&& table->current_level == current_level)
+		return table;
+
+	/* Monsters are sorted by depth */
+	table->num = 0;
+	while (table->num < filter->num && alloc_race_table[
+			filter->entries[table->num]].level <= generated_level)
+		table->num++;
+	table->total = mem_realloc(table->total, MAX(table->num, 1) *
+		sizeof(*table->total));
 
-	/* Find the monster */
-	for (i = 0; i < alloc_race_size; i++) {
-		/* Found the entry */
-		if (value < table[i].prob3) break;
+	/* Process probabilities */
+	for (i = 0; i < table->num; i++) {
+		alloc_entry *entry = &alloc_race_table[filter->entries[i]];
+		struct monster_race *race = &r_info[entry->index];
+		bool allowed = true;
+
+		/* No town monsters in dungeon */
+		if (generated_level > 0 && entry->level <= 0)
+			allowed = false;
+
+		/* No seasonal monsters outside of Christmas */
+		if (rf_has(race->flags, RF_SEASONAL) && !mon_num_seasonal)
+			allowed = false;
 
-		/* Decrement */
-		value -= table[i].prob3;
+		/* Only one copy of a unique must be around at the same time */
+		if (rf_has(race->flags, RF_UNIQUE) && (race->cur_num >= race->max_num))
+			allowed = false;
+
+		/* Some monsters never appear out of depth */
+		if (rf_has(race->flags, RF_FORCE_DEPTH) && race->level > current_level)
+			allowed = false;
+
+		/* Total */
+		if (allowed)
+			total += entry->prob1;
+		table->total[i] = total;
 	}
 
-	return &r_info[table[i].index];
+	table->current_level = current_level;
+	table->stamp = mon_num_stamp;
+	return table;
+}
+
+/**
+ * Helper function for get_mon_num(). Picks a random monster from a table
+ * of running totals.
+ */
+static struct monster_race *get_mon_race_aux(const struct mon_num_table *table)
+{
+	int lo = 0, hi = table->num - 1;
+
+	/* Pick a monster */
+	long value = randint0(table->total[hi]);
+
+	/* Find the first entry whose running total is past the value */
+	while (lo < hi) {
+		int mid = (lo + hi) / 2;
+		if (table->total[mid] > value)
+			hi = mid;
+		else
+			lo = mid + 1;
+	}
+
+	return &r_info[alloc_race_table[mon_num_filter->entries[lo]].index];
 }
 
 /**
@@ -200,9 +433,9 @@ static struct monster_race *get_mon_race_aux(long total,
  * for checks on an out-of-depth monster.
  *
  * This function uses the "prob2" field of the monster allocation table,
- * and various local information, to calculate the "prob3" field of the
- * same table, which is then used to choose an appropriate monster, in
- * a relatively efficient manner.
+ * and various local information, to calculate "prob3" as running totals in
+ * a table cached for the depth, which is then used to choose an appropriate
+ * monster, in a relatively efficient manner.
  *
  * Note that town monsters will *only* be created in the town, and
  * "normal" monsters will *never* be created in the town, unless the
@@ -220,59 +453,24 @@ static struct monster_race *get_mon_race_aux(long total,
  */
 struct monster_race *get_mon_num(int generated_level, int current_level)
 {
-	int i, p;
-	long total;
+	int p;
 	struct monster_race *race;
-	alloc_entry *table = alloc_race_table;
-	time_t cur_time = time(NULL);
-	struct tm *date = localtime(&cur_time);
+	struct mon_num_table *table;
 
 	/* Occasionally produce a nastier monster in the dungeon */
 	if (generated_level > 0 && one_in_(z_info->ood_monster_chance))
 		generated_level += MIN(generated_level / 4 + 2,
 			z_info->ood_monster_amount);
 
-	total = 0L;
-
-	/* Process probabilities */
-	for (i = 0; i < alloc_race_size; i++) {
-		/* Monsters are sorted by depth */
-		if (table[i].level > generated_level) break;
-
-		/* Default */
-		table[i].prob3 = 0;
-
-		/* No town monsters in dungeon */
-		if (generated_level > 0 && table[i].level <= 0) continue;
-
-		/* Get the chosen monster */
-		race = &r_info[table[i].index];
-
-		/* No seasonal monsters outside of Christmas */
-		if (rf_has(race->flags, RF_SEASONAL) &&
-			!(date->tm_mon == 11 && date->tm_mday >= 24 && date->tm_mday <= 26))
-			continue;
-
-		/* Only one copy of a unique must be around at the same time */
-		if (rf_has(race->flags, RF_UNIQUE) && (race->cur_num >= race->max_num))
-			continue;
-
-		/* Some monsters never appear out of depth */
-		if (rf_has(race->flags, RF_FORCE_DEPTH) && race->level > current_level)
-			continue;
-
-		/* Accept */
-		table[i].prob3 = table[i].prob2;
-
-		/* Total */
-		total += table[i].prob3;
-	}
+	/* Get the allowed races */
+	update_mon_num_season();
+	table = get_mon_num_table(generated_level, current_level);
 
 	/* No legal monsters */
-	if (total <= 0) return NULL;
+	if (!table->num || table->total[table->num - 1] <= 0) return NULL;
 
 	/* Pick a monster */
-	race = get_mon_race_aux(total, table);
+	race = get_mon_race_aux(table);
 
 	/* Try for a "harder" monster once (50%) or twice (10%) */
 	p = randint0(100);
@@ -281,7 +479,7 @@ struct monster_race *get_mon_num(int generated_level, int current_level)
 		struct monster_race *old = race;
 
 		/* Pick a new monster */
-		race = get_mon_race_aux(total, table);
+		race = get_mon_race_aux(table);
 
 		/* Keep the deepest one */
 		if (race->level < old->level) race = old;
@@ -292,7 +490,7 @@ struct monster_race *get_mon_num(int generated_level, int current_level)
 		struct monster_race *old = race;
 
 		/* Pick a monster */
-		race = get_mon_race_aux(total, table);
+		race = get_mon_race_aux(table);
 
 		/* Keep the deepest one */
 		if (race->level < old->level) race = old;
@@ -323,6 +521,7 @@ void delete_monster_idx(struct chunk *c, int m_idx)
 	/* Reduce the racial counter */
 	if (mon->original_race) mon->original_race->cur_num--;
 	else mon->race->cur_num--;
+	if (monster_is_unique(mon)) invalidate_mon_num_tables();
 
 	/* Count the number of "reproducers" */
 	if (rf_has(mon->race->flags, RF_MULTIPLY)) {
@@ -462,6 +661,9 @@ void monster_index_move(struct chunk *c, int i1, int i2)
 
 	/* Wipe hole */
 	memset(cave_monster(c, i1), 0, sizeof(struct monster));
+
+	/* Monster turn order needs redoing */
+	monsters_renumbered(c);
 }
 
 
@@ -599,6 +801,7 @@ void wipe_mon_list(struct chunk *c, struct player *p)
 		/* Reduce the racial counter */
 		if (mon->original_race) mon->original_race->cur_num--;
 		else mon->race->cur_num--;
+		if (monster_is_unique(mon)) invalidate_mon_num_tables();
 
 		/* Monster is gone from square */
 		square_set_mon(c, mon->grid, 0);
@@ -1032,6 +1235,9 @@ int16_t place_monster(struct chunk *c, struct loc grid, struct monster *mon,
 	/* Assign monster to its monster group */
 	monster_group_assign(c, new_mon, info, loading);
 
+	/* Fit the monster into the turn order */
+	monster_set_energy(c, new_mon, new_mon->energy);
+
 	update_mon(new_mon, c, true);
 
 	/* Count the number of "reproducers" */
@@ -1040,6 +1246,7 @@ int16_t place_monster(struct chunk *c, struct loc grid, struct monster *mon,
 	/* Count racial occurrences */
 	if (new_mon->original_race) new_mon->original_race->cur_num++;
 	else new_mon->race->cur_num++;
+	if (monster_is_unique(new_mon)) invalidate_mon_num_tables();
 
 	/* Create the monster's drop, if any */
 	if (origin)
@@ -1414,7 +1621,8 @@ bool place_new_monster(struct chunk *c, struct loc grid,
 		place_monster_base = friends_base->base;
 
 		/* Prepare allocation table */
-		get_mon_num_prep(place_monster_base_okay);
+		get_mon_num_prep_cached(place_monster_base_okay,
+			place_monster_base);
 
 		/* Pick a random race */
 		friends_race = get_mon_num(race->level, c->depth);
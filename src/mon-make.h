@@ -27,7 +27,10 @@ void monster_index_move(struct chunk *c, int i1, int i2);
 void compact_monsters(struct chunk *c, int num_to_compact);
 void wipe_mon_list(struct chunk *c, struct player *p);
 int16_t mon_pop(struct chunk *c);
+void invalidate_mon_num_tables(void);
 void get_mon_num_prep(bool (*get_mon_num_hook)(struct monster_race *race));
+void get_mon_num_prep_cached(bool (*get_mon_num_hook)(struct monster_race *race),
+		const void *key);
 struct monster_race *get_mon_num(int generated_level, int current_level);
 int mon_create_drop_count(const struct monster_race *race, bool maximize,
 	bool specific, int *specific_count);
@@ -115,10 +115,12 @@ static bool monster_can_hear(struct monster *mon)
  */
 static bool monster_can_smell(struct monster *mon)
 {
-	if (cave->scent.grids[mon->grid.y][mon->grid.x] == 0) {
+	int scent = square_scent(cave, mon->grid);
+
+	if (scent == 0) {
 		return false;
 	}
-	return mon->race->smell > cave->scent.grids[mon->grid.y][mon->grid.x];
+	return mon->race->smell > scent;
 }
 
 /**
@@ -372,7 +374,7 @@ static bool get_move_bodyguard(struct monster *mon)
  *
  * Ghosts and rock-eaters generally just head straight for the player. Other
  * monsters try sight, then current sound as saved in cave->noise.grids[y][x],
- * then current scent as saved in cave->scent.grids[y][x].
+ * then current scent as given by square_scent().
  *
  * This function assumes the monster is moving to an adjacent grid, and so the
  * noise can be louder by at most 1.  The monster target grid set by sound or
@@ -470,13 +472,12 @@ static bool get_move_advance(struct monster *mon, bool *track)
 		for (i = 0; i < 8; i++) {
 			/* Get the location */
 			struct loc grid = loc_sum(mon->grid, ddgrid_ddd[i]);
-			int smelled_scent;
+			int scent, smelled_scent;
 
 			/* If no good sound yet, use scent */
-			smelled_scent = mon->race->smell
-				- cave->scent.grids[grid.y][grid.x];
-			if ((smelled_scent > best_scent) &&
-				(cave->scent.grids[grid.y][grid.x] != 0)) {
+			scent = square_scent(cave, grid);
+			smelled_scent = mon->race->smell - scent;
+			if ((smelled_scent > best_scent) && (scent != 0)) {
 				best_scent = smelled_scent;
 				best_grid = grid;
 				found = true;
@@ -1869,128 +1870,431 @@ static void regen_monster(struct monster *mon, int num)
 
 /**
  * ------------------------------------------------------------------------
- * Monster processing routines to be called by the main game loop
- * ------------------------------------------------------------------------ */
-/**
- * Process all the "live" monsters, once per game turn.
+ * Monster energy and turn order
  *
- * During each game turn, we scan through the list of all the "live" monsters,
- * (backwards, so we can excise any "freshly dead" monsters), energizing each
- * monster, and allowing fully energized monsters to move, attack, pass, etc.
+ * While a level is current, a monster's energy is only brought up to date
+ * when it is processed or something changes how fast it gains energy; in
+ * between, energy holds the value as of game turn energy_turn and grows by
+ * energy_gain each turn until it reaches z_info->move_energy, at act_turn.
+ * A monster has been handled in the current turn if energy_turn is later
+ * than it, so that turn stamp takes the place of clearing MFLAG_HANDLED
+ * every turn.  Monsters with idle slots above the point the turn's final
+ * pass has reached count as handled too, having gained energy by then.
  *
- * This function and its children are responsible for a considerable fraction
- * of the processor time in normal situations, greater if the character is
- * resting.
+ * The level's schedule files each monster under the turn it will next act,
+ * so a game turn only visits the monsters which can act in it.  When the
+ * level is stored or saved, energy and MFLAG_HANDLED are written back and
+ * the schedule is dropped, to be rebuilt when the level is next processed.
+ * ------------------------------------------------------------------------ */
+/**
+ * Energy a monster gains each game turn at its current speed
  */
-void process_monsters(int minimum_energy)
+static int monster_turn_energy(const struct monster *mon)
 {
-	int i;
-	int mspeed;
+	int mspeed = mon->mspeed;
 
-	/* Only process some things every so often */
-	bool regen = false;
+	if (mon->m_timed[MON_TMD_FAST])
+		mspeed += 10;
+	if (mon->m_timed[MON_TMD_SLOW]) {
+		int slow_level = monster_effect_level(mon, MON_TMD_SLOW);
+		mspeed -= (2 * slow_level);
+	}
 
-	/* Regenerate hitpoints and mana every 100 game turns */
-	if (turn % 100 == 0)
-		regen = true;
+	return turn_energy(mspeed);
+}
 
-	/* Process the monsters (backwards) */
-	for (i = cave_monster_max(cave) - 1; i >= 1; i--) {
-		struct monster *mon;
-		bool moving;
+/**
+ * Energy a monster will have at the start of game turn `when`; monsters stop
+ * gaining energy once they have enough to act, until they do so
+ */
+static int monster_energy_at(const struct monster *mon, int32_t when)
+{
+	int energy = mon->energy;
+	int32_t turns = when - mon->energy_turn;
+	int32_t needed;
 
-		/* Handle "leaving" */
-		if (player->is_dead || player->upkeep->generate_level) break;
+	if (turns <= 0 || energy >= z_info->move_energy || !mon->energy_gain)
+		return energy;
 
-		/* Get a 'live' monster */
-		mon = cave_monster(cave, i);
+	needed = (z_info->move_energy - energy + mon->energy_gain - 1) /
+		mon->energy_gain;
+	return energy + MIN(turns, needed) * mon->energy_gain;
+}
+
+/**
+ * Game turn a monster will next have enough energy to act, or -1 for never
+ */
+static int32_t monster_act_turn(const struct monster *mon)
+{
+	int energy = mon->energy;
+
+	if (energy >= z_info->move_energy)
+		return mon->energy_turn;
+	if (!mon->energy_gain)
+		return -1;
+	return mon->energy_turn + (z_info->move_energy - energy +
+		mon->energy_gain - 1) / mon->energy_gain;
+}
+
+/**
+ * Has a monster already been handled during this game turn?
+ */
+static bool monster_handled(const struct mon_schedule *s,
+		const struct monster *mon)
+{
+	if (mon->energy_turn > turn)
+		return true;
+	return s->sweep_turn == turn && mon->midx > s->sweep_pos;
+}
+
+/**
+ * Bring a monster's energy up to date, at the speed it had so far
+ */
+static void monster_catch_up(const struct mon_schedule *s,
+		struct monster *mon)
+{
+	int32_t now = monster_handled(s, mon) ? turn + 1 : turn;
+
+	if (mon->energy_turn >= now) return;
+	mon->energy = monster_energy_at(mon, now);
+	mon->energy_turn = now;
+}
+
+/**
+ * File a monster under the turn it is next due to act
+ */
+static void monster_schedule(struct mon_schedule *s, struct monster *mon)
+{
+	int32_t when = monster_act_turn(mon);
+	struct mon_bucket *b;
+	int i;
+
+	/* Already filed */
+	if (when == mon->act_turn) return;
+	mon->act_turn = when;
+	if (when < 0) return;
+
+	/* Keep the bucket in descending index order */
+	b = &s->buckets[when % s->num_buckets];
+	if (b->num == b->size) {
+		b->size = b->size ? 2 * b->size : 8;
+		b->midx = mem_realloc(b->midx, b->size * sizeof(*b->midx));
+	}
+	for (i = b->num; i > 0 && b->midx[i - 1] < mon->midx; i--)
+		b->midx[i] = b->midx[i - 1];
+	b->midx[i] = mon->midx;
+	b->num++;
+}
+
+/**
+ * Refile every monster in a chunk, after monster indices have changed
+ */
+static void monsters_reschedule(struct chunk *c)
+{
+	struct mon_schedule *s = &c->mon_schedule;
+	int i;
+
+	for (i = 0; i < s->num_buckets; i++)
+		s->buckets[i].num = 0;
+
+	/* Going backwards, every monster goes on the end of its bucket */
+	for (i = cave_monster_max(c) - 1; i >= 1; i--) {
+		struct monster *mon = cave_monster(c, i);
 		if (!mon->race) continue;
+		mon->act_turn = -1;
+		monster_schedule(s, mon);
+	}
+	s->stale = false;
+}
+
+/**
+ * Start keeping a chunk's monster schedule, taking each monster's energy and
+ * MFLAG_HANDLED as correct for the current turn
+ */
+static void monsters_start_schedule(struct chunk *c)
+{
+	struct mon_schedule *s = &c->mon_schedule;
+	int i;
+
+	/* Monsters act at most move_energy + 1 turns ahead */
+	s->num_buckets = 1;
+	while (s->num_buckets < z_info->move_energy + 2)
+		s->num_buckets *= 2;
+	s->buckets = mem_zalloc(s->num_buckets * sizeof(*s->buckets));
+	s->sweep_turn = -1;
+	s->sweep_pos = 0;
 
-		/* Ignore monsters that have already been handled */
+	for (i = 1; i < cave_monster_max(c); i++) {
+		struct monster *mon = cave_monster(c, i);
+		if (!mon->race) continue;
+		mon->energy_turn = turn;
 		if (mflag_has(mon->mflag, MFLAG_HANDLED))
-			continue;
+			mon->energy_turn++;
+		mon->energy_gain = monster_turn_energy(mon);
+	}
+	monsters_reschedule(c);
+}
+
+/**
+ * Set a monster's energy, as when it is placed or summoned
+ */
+void monster_set_energy(struct chunk *c, struct monster *mon, int energy)
+{
+	struct mon_schedule *s = &c->mon_schedule;
+
+	if (!s->buckets) {
+		mon->energy = energy;
+		return;
+	}
+
+	mon->energy_turn = monster_handled(s, mon) ? turn + 1 : turn;
+	mon->energy = energy;
+	mon->energy_gain = monster_turn_energy(mon);
+	monster_schedule(s, mon);
+}
 
-		/* Not enough energy to move yet */
-		if (mon->energy < minimum_energy) continue;
+/**
+ * Account for a change in how fast a monster gains energy, from its speed
+ * or timed effects changing
+ */
+void monster_speed_changed(struct chunk *c, struct monster *mon)
+{
+	struct mon_schedule *s = &c->mon_schedule;
 
-		/* Does this monster have enough energy to move? */
-		moving = mon->energy >= z_info->move_energy ? true : false;
+	if (!s->buckets || cave_monster(c, mon->midx) != mon) return;
 
-		/* Prevent reprocessing */
-		mflag_on(mon->mflag, MFLAG_HANDLED);
+	monster_catch_up(s, mon);
+	mon->energy_gain = monster_turn_energy(mon);
+	monster_schedule(s, mon);
+}
 
-		/* Handle monster regeneration if requested */
-		if (regen)
-			regen_monster(mon, 1);
+/**
+ * Note that monster indices in a chunk have changed
+ */
+void monsters_renumbered(struct chunk *c)
+{
+	c->mon_schedule.stale = true;
+}
 
-		/* Calculate the net speed */
-		mspeed = mon->mspeed;
-		if (mon->m_timed[MON_TMD_FAST])
-			mspeed += 10;
-		if (mon->m_timed[MON_TMD_SLOW]) {
-			int slow_level = monster_effect_level(mon, MON_TMD_SLOW);
-			mspeed -= (2 * slow_level);
-		}
+/**
+ * Bring all monster energy in a chunk up to date and set MFLAG_HANDLED to
+ * match, then drop the schedule; done before the level is stored or saved
+ */
+void monsters_sync_energy(struct chunk *c)
+{
+	struct mon_schedule *s = &c->mon_schedule;
+	int i;
 
-		/* Give this monster some energy */
-		mon->energy += turn_energy(mspeed);
+	if (!s->buckets) return;
+
+	for (i = 1; i < cave_monster_max(c); i++) {
+		struct monster *mon = cave_monster(c, i);
+		if (!mon->race) continue;
+		monster_catch_up(s, mon);
+		if (mon->energy_turn > turn)
+			mflag_on(mon->mflag, MFLAG_HANDLED);
+		else
+			mflag_off(mon->mflag, MFLAG_HANDLED);
+	}
+
+	for (i = 0; i < s->num_buckets; i++)
+		mem_free(s->buckets[i].midx);
+	mem_free(s->buckets);
+	s->buckets = NULL;
+}
 
-		/* End the turn of monsters without enough energy to move */
-		if (!moving)
-			continue;
 
-		/* Use up "some" energy */
+/**
+ * ------------------------------------------------------------------------
+ * Monster processing routines to be called by the main game loop
+ * ------------------------------------------------------------------------ */
+/**
+ * Energize one monster if it has not been handled yet this game turn and has
+ * at least minimum_energy, and let it move, attack, pass, etc if it had
+ * enough energy.
+ */
+static void process_monster(int i, int minimum_energy, bool regen)
+{
+	struct monster *mon = cave_monster(cave, i);
+	int energy;
+	bool moving;
+
+	/* Get a 'live' monster */
+	if (!mon->race) return;
+
+	/* Ignore monsters that have already been handled */
+	if (monster_handled(&cave->mon_schedule, mon)) return;
+
+	/* Not enough energy to move yet */
+	energy = monster_energy_at(mon, turn);
+	if (energy < minimum_energy) return;
+
+	/* Does this monster have enough energy to move? */
+	moving = energy >= z_info->move_energy ? true : false;
+
+	/* Handle monster regeneration if requested */
+	if (regen)
+		regen_monster(mon, 1);
+
+	/* Give this monster some energy, which also prevents reprocessing */
+	mon->energy_gain = monster_turn_energy(mon);
+	mon->energy = energy + mon->energy_gain;
+	mon->energy_turn = turn + 1;
+
+	/* Use up "some" energy */
+	if (moving)
 		mon->energy -= z_info->move_energy;
+	monster_schedule(&cave->mon_schedule, mon);
+
+	/* End the turn of monsters without enough energy to move */
+	if (!moving)
+		return;
 
-		/* Mimics lie in wait */
-		if (monster_is_mimicking(mon)) continue;
+	/* Mimics lie in wait */
+	if (monster_is_mimicking(mon)) return;
 
-		/* Check if the monster is active */
-		if (monster_check_active(mon)) {
-			/* Process timed effects - skip turn if necessary */
-			if (process_monster_timed(mon))
-				continue;
+	/* Check if the monster is active */
+	if (monster_check_active(mon)) {
+		/* Process timed effects - skip turn if necessary */
+		if (process_monster_timed(mon))
+			return;
 
-			/* Set this monster to be the current actor */
-			cave->mon_current = i;
+		/* Set this monster to be the current actor */
+		cave->mon_current = i;
 
-			/* The monster takes its turn */
-			monster_turn(mon);
+		/* The monster takes its turn */
+		monster_turn(mon);
 
-			/*
-			 * For symmetry with the player, monster can take
-			 * terrain damage after its turn.
-			 */
-			monster_take_terrain_damage(mon);
+		/*
+		 * For symmetry with the player, monster can take
+		 * terrain damage after its turn.
+		 */
+		monster_take_terrain_damage(mon);
+
+		/* Monster is no longer current */
+		cave->mon_current = -1;
+	}
+}
+
+/**
+ * Process all the "live" monsters, once per game turn.
+ *
+ * During each game turn, we go through the "live" monsters (backwards, so we
+ * can excise any "freshly dead" monsters), energizing each monster, and
+ * allowing fully energized monsters to move, attack, pass, etc.  The final
+ * call in a turn has minimum_energy 0; earlier ones only take monsters with
+ * more energy than the player.
+ *
+ * Usually only the monsters due to act this turn are visited, in the same
+ * order a scan of the whole list would reach them; the others have their
+ * energy brought up to date when it matters.  Every monster is visited on
+ * turns when they regenerate, or when the schedule has been upset.
+ *
+ * This function and its children are responsible for a considerable fraction
+ * of the processor time in normal situations, greater if the character is
+ * resting.
+ */
+void process_monsters(int minimum_energy)
+{
+	struct mon_schedule *s = &cave->mon_schedule;
+	struct mon_bucket *b;
+	int i, j;
+
+	/* Only process some things every so often */
+	bool regen = false;
+
+	/* Regenerate hitpoints and mana every 100 game turns */
+	if (turn % 100 == 0)
+		regen = true;
+
+	/* Get the schedule ready */
+	if (!s->buckets)
+		monsters_start_schedule(cave);
+	else if (s->stale)
+		monsters_reschedule(cave);
+
+	/* Note how far the final pass has got */
+	if (!minimum_energy) {
+		s->sweep_turn = turn;
+		s->sweep_pos = cave_monster_max(cave);
+	}
+
+	/* Take the monsters due to act now, as long as nothing else has to */
+	i = cave_monster_max(cave);
+	if (!regen && (!minimum_energy
+			|| minimum_energy >= z_info->move_energy)) {
+		b = &s->buckets[turn % s->num_buckets];
+		j = 0;
+		while (j < b->num && !s->stale) {
+			/* Handle "leaving" */
+			if (player->is_dead || player->upkeep->generate_level)
+				break;
 
-			/* Monster is no longer current */
-			cave->mon_current = -1;
+			/* Skip anything already passed over, then process */
+			if (b->midx[j] >= i) {
+				j++;
+				continue;
+			}
+			i = b->midx[j];
+			if (!minimum_energy)
+				s->sweep_pos = i;
+			process_monster(i, minimum_energy, regen);
 		}
+
+		/* Carry on down the whole list if indices changed */
+		if (!s->stale)
+			i = 1;
+	}
+
+	/* Process the monsters (backwards) */
+	for (i--; i >= 1; i--) {
+		/* Handle "leaving" */
+		if (player->is_dead || player->upkeep->generate_level) break;
+
+		if (!minimum_energy)
+			s->sweep_pos = i;
+		process_monster(i, minimum_energy, regen);
 	}
 
+	/* The final pass got through every monster */
+	if (!minimum_energy && !player->is_dead
+			&& !player->upkeep->generate_level)
+		s->sweep_pos = 0;
+
 	/* Update monster visibility after this */
 	/* XXX This may not be necessary */
 	player->upkeep->update |= PU_MONSTERS;
 }
 
 /**
- * Clear 'moved' status from all monsters.
+ * Finish the game turn for all monsters, so they are ready to act when they
+ * have the energy.
  *
- * Clear noise if appropriate.
+ * Monsters the final pass did not reach, because it was cut short, gain no
+ * energy this turn.
  */
 void reset_monsters(void)
 {
+	struct mon_schedule *s = &cave->mon_schedule;
 	int i;
-	struct monster *mon;
+
+	if (!s->buckets) return;
 
 	/* Process the monsters (backwards) */
-	for (i = cave_monster_max(cave) - 1; i >= 1; i--) {
+	for (i = s->sweep_pos; i >= 1; i--) {
 		/* Access the monster */
-		mon = cave_monster(cave, i);
+		struct monster *mon = cave_monster(cave, i);
+		if (!mon->race || mon->energy_turn > turn) continue;
 
-		/* Monster is ready to go again */
-		mflag_off(mon->mflag, MFLAG_HANDLED);
+		/* Monster loses its turn */
+		mon->energy = monster_energy_at(mon, turn);
+		mon->energy_turn = turn + 1;
+		monster_schedule(s, mon);
 	}
+	s->sweep_pos = 0;
+
+	/* Nothing more is due this turn */
+	s->buckets[turn % s->num_buckets].num = 0;
 }
 
 /**
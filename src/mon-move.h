@@ -25,6 +25,10 @@ enum monster_stagger {
 	 INNATE_STAGGER = 2
 };
 
+void monster_set_energy(struct chunk *c, struct monster *mon, int energy);
+void monster_speed_changed(struct chunk *c, struct monster *mon);
+void monsters_renumbered(struct chunk *c);
+void monsters_sync_energy(struct chunk *c);
 bool multiply_monster(const struct monster *mon);
 void process_monsters(int minimum_energy);
 void reset_monsters(void);
@@ -23,6 +23,7 @@
 #include "init.h"
 #include "mon-group.h"
 #include "mon-make.h"
+#include "mon-move.h"
 #include "mon-summon.h"
 #include "mon-util.h"
 #include "parser.h"
@@ -302,6 +303,20 @@ static bool summon_specific_okay(struct monster_race *race)
 	return true;
 }
 
+/**
+ * Prepare the allocation table for summon_specific_type, reusing the races
+ * allowed the last time that type (or kin of the same base) was summoned
+ */
+static void summon_specific_prep(void)
+{
+	if (summon_specific_type == summon_name_to_idx("KIN")) {
+		get_mon_num_prep_cached(summon_specific_okay, kin_base);
+	} else {
+		get_mon_num_prep_cached(summon_specific_okay,
+			&summons[summon_specific_type]);
+	}
+}
+
 /**
  * Check to see if you can call the monster
  */
@@ -372,7 +387,7 @@ static int call_monster(struct loc grid)
 	monster_wake(mon, false, 100);
 
 	/* Set it's energy to 0 */
-	mon->energy = 0;
+	monster_set_energy(cave, mon, 0);
 
 	return (mon->race->level);
 }
@@ -427,7 +442,7 @@ int summon_specific(struct loc grid, int lev, int type, bool delay, bool call)
 	}
 
 	/* Prepare allocation table */
-	get_mon_num_prep(summon_specific_okay);
+	summon_specific_prep();
 
 	/* Pick a monster, using the level calculation */
 	race = get_mon_num((player->depth + lev) / 2 + 5, player->depth);
@@ -472,7 +487,7 @@ int summon_specific(struct loc grid, int lev, int type, bool delay, bool call)
 			 + m_e_per_turn * p_e_per_turn - 1)
 			 / (m_e_per_turn * p_e_per_turn);
 
-		mon->energy = 0;
+		monster_set_energy(cave, mon, 0);
 		if (turns > 0) {
 			/* Set timer directly to avoid resistance */
 			mon->m_timed[MON_TMD_HOLD] = MIN(turns, 32767);
@@ -493,7 +508,7 @@ struct monster_race *select_shape(struct monster *mon, int type)
 	summon_specific_type = type;
 
 	/* Prepare allocation table */
-	get_mon_num_prep(summon_specific_okay);
+	summon_specific_prep();
 
 	/* Pick a monster */
 	race = get_mon_num(player->depth + 5, player->depth);
@@ -19,6 +19,7 @@
 #include "angband.h"
 #include "mon-desc.h"
 #include "mon-lore.h"
+#include "mon-move.h"
 #include "mon-msg.h"
 #include "mon-predicate.h"
 #include "mon-spell.h"
@@ -206,6 +207,12 @@ static bool mon_set_timed(struct monster *mon,
 		}
 	}
 
+	/* Monster may now gain energy at a different rate */
+	if (update && (effect_type == MON_TMD_FAST || effect_type == MON_TMD_SLOW
+			|| effect_type == MON_TMD_CHANGED)) {
+		monster_speed_changed(cave, mon);
+	}
+
 	/* Print a message if there is one, if the effect allows for it, and if
 	 * either the monster is visible, or we're trying to ID something */
 	if (m_note &&
@@ -46,6 +46,7 @@
 #include "player-util.h"
 #include "project.h"
 #include "trap.h"
+#include "z-strmap.h"
 
 /**
  * ------------------------------------------------------------------------
@@ -111,6 +112,61 @@ void create_mon_flag_mask(bitflag *f, ...)
  * ------------------------------------------------------------------------
  * Lookup utilities
  * ------------------------------------------------------------------------ */
+/**
+ * Indexes of race and base names, built when first needed.  Each remembers
+ * the data it was built from, and is rebuilt if that changes.
+ */
+static struct strmap *race_names;
+static const struct monster_race *race_names_info;
+static int race_names_max;
+static struct strmap *base_names;
+static const struct monster_base *base_names_info;
+
+/**
+ * Forget the indexes of race and base names, so they are rebuilt from the
+ * current data when next needed.
+ */
+void reset_monster_lookups(void)
+{
+	strmap_free(race_names);
+	race_names = NULL;
+	race_names_info = NULL;
+	strmap_free(base_names);
+	base_names = NULL;
+	base_names_info = NULL;
+}
+
+/**
+ * Return the race whose name is exactly name, ignoring case, or NULL.  Where
+ * races share a name the first is found, as by a scan of r_info.
+ */
+static struct monster_race *find_race_name(const char *name)
+{
+	struct monster_race *race;
+	uintptr_t idx;
+
+	if (!r_info) return NULL;
+	if (!race_names || race_names_info != r_info
+			|| race_names_max != z_info->r_max) {
+		int i;
+
+		strmap_free(race_names);
+		race_names = strmap_new(true);
+		race_names_info = r_info;
+		race_names_max = z_info->r_max;
+		for (i = 0; i < z_info->r_max; i++) {
+			if (r_info[i].name)
+				strmap_add(race_names, r_info[i].name,
+					(void *)(uintptr_t)(i + 1));
+		}
+	}
+
+	idx = (uintptr_t)strmap_get(race_names, name);
+	if (!idx) return NULL;
+	race = &r_info[idx - 1];
+	return (race->name && !my_stricmp(name, race->name)) ? race : NULL;
+}
+
 /**
  * Returns the monster with the given name. If no monster has the exact name
  * given, returns the first monster with the given name as a (case-insensitive)
@@ -119,7 +175,9 @@ void create_mon_flag_mask(bitflag *f, ...)
 struct monster_race *lookup_monster(const char *name)
 {
 	int i;
-	struct monster_race *closest = NULL;
+	struct monster_race *closest = find_race_name(name);
+
+	if (closest) return closest;
 
 	/* Look for it */
 	for (i = 0; i < z_info->r_max; i++) {
@@ -147,6 +205,19 @@ struct monster_base *lookup_monster_base(const char *name)
 {
 	struct monster_base *base;
 
+	/* Try the index */
+	if (rb_info) {
+		if (!base_names || base_names_info != rb_info) {
+			strmap_free(base_names);
+			base_names = strmap_new(false);
+			base_names_info = rb_info;
+			for (base = rb_info; base; base = base->next)
+				strmap_add(base_names, base->name, base);
+		}
+		base = strmap_get(base_names, name);
+		if (base && streq(name, base->name)) return base;
+	}
+
 	/* Look for it */
 	for (base = rb_info; base; base = base->next) {
 		if (streq(name, base->name))
@@ -1088,6 +1159,7 @@ static void player_kill_monster(struct monster *mon, struct player *p,
 		char unique_name[80];
 		assert(mon->original_race == NULL);
 		mon->race->max_num = 0;
+		invalidate_mon_num_tables();
 
 		/*
 		 * This gets the correct name if we slay an invisible
@@ -1609,7 +1681,7 @@ bool monster_change_shape(struct monster *mon)
 			shape_base = shape->base;
 
 			/* Choose a race of the given base */
-			get_mon_num_prep(monster_base_shape_okay);
+			get_mon_num_prep_cached(monster_base_shape_okay, shape_base);
 
 			/* Pick a random race */
 			race = get_mon_num(player->depth + 5, player->depth);
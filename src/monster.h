@@ -395,7 +395,11 @@ struct monster {
 	int16_t m_timed[MON_TMD_MAX];		/* Timed monster status effects */
 
 	uint8_t mspeed;				/* Monster "speed" */
-	uint8_t energy;				/* Monster "energy" */
+	uint8_t energy;				/* Monster "energy" as of energy_turn */
+	uint8_t energy_gain;			/* Energy gained per game turn */
+	int32_t energy_turn;			/* Next turn to give energy; past the
+						 * current turn once handled */
+	int32_t act_turn;			/* Turn next due to act, or -1 */
 
 	uint8_t cdis;				/* Current dis from player */
 
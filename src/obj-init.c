@@ -2213,6 +2213,8 @@ static errr finish_parse_object(struct parser *p) {
 static void cleanup_object(void)
 {
 	int idx;
+
+	reset_object_lookups();
 	for (idx = 0; idx < z_info->k_max; idx++) {
 		struct object_kind *kind = &k_info[idx];
 		string_free(kind->name);
@@ -2652,6 +2654,8 @@ static errr finish_parse_ego(struct parser *p) {
 static void cleanup_ego(void)
 {
 	int idx;
+
+	reset_object_lookups();
 	for (idx = 0; idx < z_info->e_max; idx++) {
 		struct ego_item *ego = &e_info[idx];
 		struct poss_item *poss;
@@ -3096,6 +3100,8 @@ static errr finish_parse_artifact(struct parser *p) {
 static void cleanup_artifact(void)
 {
 	int idx;
+
+	reset_object_lookups();
 	for (idx = 0; idx < z_info->a_max; idx++) {
 		struct artifact *art = &a_info[idx];
 		string_free(art->name);
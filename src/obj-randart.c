@@ -3180,6 +3180,9 @@ void do_randart(uint32_t randart_seed, bool create_file)
 	create_artifact_set(standarts);
 	artifact_set_data_free(standarts);
 
+	/* The artifacts have new names */
+	reset_object_lookups();
+
 	/* Look at the frequencies on the finished items */
 	randarts = artifact_set_data_new();
 	store_base_power(randarts);
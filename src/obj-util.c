@@ -42,6 +42,7 @@
 #include "player-util.h"
 #include "randname.h"
 #include "z-queue.h"
+#include "z-strmap.h"
 
 struct object_base *kb_info;
 struct object_kind *k_info;
@@ -482,6 +483,188 @@ unsigned check_for_inscrip_with_int(const struct object *obj, const char *inscri
 	return i;
 }
 
+/*** Lookup indexes ***/
+
+/**
+ * Indexes over k_info, a_info and e_info, built when first needed.  Each
+ * remembers the array and count it was built from and is rebuilt if either
+ * changes; every hit is checked against the data, and a miss falls back to
+ * searching the arrays, so a stale index is slow but never wrong.
+ */
+static struct {
+	const struct object_kind *info;
+	int max;
+
+	/* First kidx + 1 for each tval and sval, from kind_start[tval] */
+	int kind_start[TV_MAX];
+	int kind_svals[TV_MAX];
+	int *kinds;
+
+	/* Formatted kind names to first kidx + 1, for each tval */
+	struct strmap *sval_names[TV_MAX];
+} kind_index;
+
+static struct {
+	const struct artifact *info;
+	int max;
+	struct strmap *names;
+} art_index;
+
+static struct {
+	const struct ego_item *info;
+	int max;
+	struct strmap *names;
+
+	/* eidx + 1 of the next ego with the same name, or 0 */
+	int *next;
+} ego_index;
+
+static void free_kind_index(void)
+{
+	int i;
+
+	mem_free(kind_index.kinds);
+	for (i = 0; i < TV_MAX; i++)
+		strmap_free(kind_index.sval_names[i]);
+	memset(&kind_index, 0, sizeof(kind_index));
+}
+
+static void build_kind_index(void)
+{
+	int k, tval, total = 0;
+
+	free_kind_index();
+	kind_index.info = k_info;
+	kind_index.max = z_info->k_max;
+
+	/* Lay out a row of svals for each tval */
+	for (k = 0; k < z_info->k_max; k++) {
+		const struct object_kind *kind = &k_info[k];
+
+		if (kind->tval <= 0 || kind->tval >= TV_MAX || kind->sval < 0)
+			continue;
+		kind_index.kind_svals[kind->tval] =
+			MAX(kind_index.kind_svals[kind->tval], kind->sval + 1);
+	}
+	for (tval = 0; tval < TV_MAX; tval++) {
+		kind_index.kind_start[tval] = total;
+		total += kind_index.kind_svals[tval];
+	}
+	kind_index.kinds = mem_zalloc(MAX(total, 1) * sizeof(int));
+
+	for (k = 0; k < z_info->k_max; k++) {
+		const struct object_kind *kind = &k_info[k];
+		int *slot;
+
+		if (kind->tval <= 0 || kind->tval >= TV_MAX || kind->sval < 0)
+			continue;
+		slot = &kind_index.kinds[kind_index.kind_start[kind->tval]
+			+ kind->sval];
+		if (!*slot) *slot = k + 1;
+
+		if (kind->name) {
+			char name[1024];
+
+			if (!kind_index.sval_names[kind->tval])
+				kind_index.sval_names[kind->tval] = strmap_new(true);
+			obj_desc_name_format(name, sizeof name, 0, kind->name, 0,
+				false);
+			strmap_add(kind_index.sval_names[kind->tval], name,
+				(void *)(uintptr_t)(k + 1));
+		}
+	}
+}
+
+/**
+ * Bring the kind index up to date with k_info; false if there are no kinds.
+ */
+static bool kind_index_current(void)
+{
+	if (!k_info) return false;
+	if (!kind_index.kinds || kind_index.info != k_info
+			|| kind_index.max != z_info->k_max)
+		build_kind_index();
+	return true;
+}
+
+static void free_art_index(void)
+{
+	strmap_free(art_index.names);
+	memset(&art_index, 0, sizeof(art_index));
+}
+
+static bool art_index_current(void)
+{
+	int i;
+
+	if (!a_info) return false;
+	if (art_index.names && art_index.info == a_info
+			&& art_index.max == z_info->a_max)
+		return true;
+
+	free_art_index();
+	art_index.info = a_info;
+	art_index.max = z_info->a_max;
+	art_index.names = strmap_new(false);
+	for (i = 0; i < z_info->a_max; i++) {
+		if (a_info[i].name)
+			strmap_add(art_index.names, a_info[i].name,
+				(void *)(uintptr_t)(i + 1));
+	}
+	return true;
+}
+
+static void free_ego_index(void)
+{
+	strmap_free(ego_index.names);
+	mem_free(ego_index.next);
+	memset(&ego_index, 0, sizeof(ego_index));
+}
+
+static bool ego_index_current(void)
+{
+	int i;
+
+	if (!e_info) return false;
+	if (ego_index.names && ego_index.info == e_info
+			&& ego_index.max == z_info->e_max)
+		return true;
+
+	free_ego_index();
+	ego_index.info = e_info;
+	ego_index.max = z_info->e_max;
+	ego_index.names = strmap_new(false);
+	ego_index.next = mem_zalloc(MAX(z_info->e_max, 1) * sizeof(int));
+	for (i = 0; i < z_info->e_max; i++) {
+		int e;
+
+		if (!e_info[i].name) continue;
+		e = (int)(uintptr_t)strmap_get(ego_index.names, e_info[i].name);
+		if (!e) {
+			strmap_add(ego_index.names, e_info[i].name,
+				(void *)(uintptr_t)(i + 1));
+			continue;
+		}
+
+		/* Chain it after the others with its name */
+		while (ego_index.next[e - 1])
+			e = ego_index.next[e - 1];
+		ego_index.next[e - 1] = i + 1;
+	}
+	return true;
+}
+
+/**
+ * Forget the lookup indexes, so they are rebuilt from the current data when
+ * next needed.
+ */
+void reset_object_lookups(void)
+{
+	free_kind_index();
+	free_art_index();
+	free_ego_index();
+}
+
 /*** Object kind lookup functions ***/
 
 /**
@@ -491,6 +674,14 @@ struct object_kind *lookup_kind(int tval, int sval)
 {
 	int k;
 
+	/* Try the index */
+	if (tval > 0 && tval < TV_MAX && sval >= 0 && kind_index_current()
+			&& sval < kind_index.kind_svals[tval]) {
+		k = kind_index.kinds[kind_index.kind_start[tval] + sval];
+		if (k && k_info[k - 1].tval == tval && k_info[k - 1].sval == sval)
+			return &k_info[k - 1];
+	}
+
 	/* Look for it */
 	for (k = 0; k < z_info->k_max; k++) {
 		struct object_kind *kind = &k_info[k];
@@ -520,6 +711,13 @@ const struct artifact *lookup_artifact_name(const char *name)
 	int i;
 	int a_idx = -1;
 
+	/* Try the index */
+	if (art_index_current()) {
+		i = (int)(uintptr_t)strmap_get(art_index.names, name);
+		if (i && a_info[i - 1].name && streq(name, a_info[i - 1].name))
+			return &a_info[i - 1];
+	}
+
 	/* Look for it */
 	for (i = 0; i < z_info->a_max; i++) {
 		const struct artifact *art = &a_info[i];
@@ -549,8 +747,24 @@ struct ego_item *lookup_ego_item(const char *name, int tval, int sval)
 	struct object_kind *kind = lookup_kind(tval, sval);
 	int i;
 
-	/* Look for it */
 	if (!kind) return NULL;
+
+	/* Try the index */
+	if (ego_index_current()) {
+		i = (int)(uintptr_t)strmap_get(ego_index.names, name);
+		while (i && e_info[i - 1].name && streq(name, e_info[i - 1].name)) {
+			struct ego_item *ego = &e_info[i - 1];
+			struct poss_item *poss_item;
+
+			for (poss_item = ego->poss_items; poss_item;
+					poss_item = poss_item->next) {
+				if (kind->kidx == poss_item->kidx) return ego;
+			}
+			i = ego_index.next[i - 1];
+		}
+	}
+
+	/* Look for it */
 	for (i = 0; i < z_info->e_max; i++) {
 		struct ego_item *ego = &e_info[i];
 		struct poss_item *poss_item = ego->poss_items;
@@ -585,6 +799,19 @@ int lookup_sval(int tval, const char *name)
 		return (contains_only_spaces(pe) && r < INT_MAX) ? (int)r : -1;
 	}
 
+	/* Try the index */
+	if (tval > 0 && tval < TV_MAX && kind_index_current()
+			&& kind_index.sval_names[tval]) {
+		k = (int)(uintptr_t)strmap_get(kind_index.sval_names[tval], name);
+		if (k && k_info[k - 1].tval == tval && k_info[k - 1].name) {
+			char cmp_name[1024];
+
+			obj_desc_name_format(cmp_name, sizeof cmp_name, 0,
+				k_info[k - 1].name, 0, false);
+			if (!my_stricmp(cmp_name, name)) return k_info[k - 1].sval;
+		}
+	}
+
 	/* Look for it */
 	for (k = 0; k < z_info->k_max; k++) {
 		struct object_kind *kind = &k_info[k];
@@ -29,10 +29,14 @@
 
 /**
  * A parser has a list of hooks (which are run across new lines given to
- * parser_parse()) and a list of the set of named values for the current line.
+ * parser_parse()) and an array of the values for the current line.
  * Each hook has a list of specs, which are essentially named formal parameters;
  * when we run a particular hook across a line, each spec in the hook is
- * assigned a value.
+ * assigned a value in the slot of the same position.
+ *
+ * Hooks are found from their directive through a hash table, and each hook
+ * has a small hash table from the names of its specs to their slots, so
+ * neither finding the hook for a line nor getting a value walks a list.
  */
 
 enum {
@@ -53,7 +57,7 @@ struct parser_spec {
 };
 
 struct parser_value {
-	struct parser_spec spec;
+	int type;
 	union {
 		wchar_t cval;
 		int ival;
@@ -64,11 +68,18 @@ struct parser_value {
 };
 
 struct parser_hook {
-	struct parser_hook *next;
+	struct parser_hook *next;		/* All hooks, newest first */
+	struct parser_hook *chain;		/* Next hook in the same bucket */
 	enum parser_error (*func)(struct parser *p);
 	char *dir;
+	uint32_t hash;
+	uint32_t index;					/* Order of registration */
 	struct parser_spec *fhead;
 	struct parser_spec *ftail;
+	int nspecs;
+	struct parser_spec **specs;		/* Specs by slot */
+	uint8_t *slots;					/* Slot + 1 by hash of name, or 0 */
+	uint32_t slot_mask;
 };
 
 struct parser {
@@ -77,9 +88,20 @@ struct parser {
 	unsigned int colno;
 	char errmsg[1024];
 	struct parser_hook *hooks;
-	struct parser_value *fhead;
-	struct parser_value *ftail;
+	struct parser_hook **table;
+	uint32_t table_mask;
+	uint32_t nhooks;
+	struct parser_hook *cur;
+	struct parser_value *vals;
+	int nvals;
+	int max_vals;
+	char *line;
+	size_t line_size;
 	void *priv;
+	uint8_t *rec;
+	size_t rec_len;
+	size_t rec_size;
+	bool recording;
 };
 
 /**
@@ -90,26 +112,83 @@ struct parser *parser_new(void) {
 	return p;
 }
 
+static uint32_t hash_name(const char *name) {
+	uint32_t hash = 0x811c9dc5;
+
+	while (*name)
+		hash = (hash ^ (uint8_t)*name++) * 0x01000193;
+	return hash;
+}
+
 static struct parser_hook *findhook(struct parser *p, const char *dir) {
-	struct parser_hook *h = p->hooks;
-	while (h) {
-		if (streq(h->dir, dir))
+	struct parser_hook *h;
+	uint32_t hash;
+
+	if (!p->table) return NULL;
+	hash = hash_name(dir);
+	for (h = p->table[hash & p->table_mask]; h; h = h->chain) {
+		if (h->hash == hash && streq(h->dir, dir))
 			break;
-		h = h->next;
 	}
 	return h;
 }
 
-static void parser_freeold(struct parser *p) {
-	struct parser_value *v;
-	while (p->fhead) {
-		int t = p->fhead->spec.type & ~PARSE_T_OPT;
-		v = (struct parser_value *)p->fhead->spec.next;
-		if (t == PARSE_T_SYM || t == PARSE_T_STR)
-			mem_free(p->fhead->u.sval);
-		mem_free(p->fhead);
-		p->fhead = v;
+/**
+ * Put h in the directive table, in place of any hook with the same directive.
+ */
+static void table_insert(struct parser *p, struct parser_hook *h) {
+	struct parser_hook **link = &p->table[h->hash & p->table_mask];
+
+	while (*link) {
+		if ((*link)->hash == h->hash && streq((*link)->dir, h->dir)) {
+			h->chain = (*link)->chain;
+			*link = h;
+			return;
+		}
+		link = &(*link)->chain;
 	}
+	h->chain = NULL;
+	*link = h;
+}
+
+/**
+ * Make the directive table big enough for the hooks, rebuilding it from the
+ * hook list if it grows.  The list is newest first, so older hooks with the
+ * same directive as a newer one stay superseded.
+ */
+static void table_grow(struct parser *p) {
+	uint32_t size = p->table ? p->table_mask + 1 : 0, n = 64;
+	struct parser_hook *h;
+
+	if (2 * p->nhooks <= size) return;
+	while (n < 2 * p->nhooks) n *= 2;
+	mem_free(p->table);
+	p->table = mem_zalloc(n * sizeof(*p->table));
+	p->table_mask = n - 1;
+	for (h = p->hooks; h; h = h->next) {
+		if (!findhook(p, h->dir)) table_insert(p, h);
+	}
+}
+
+/**
+ * Returns the slot of the spec called name in h, or -1 if there is none.
+ */
+static int hook_slot(struct parser_hook *h, const char *name) {
+	uint32_t i;
+
+	if (!h || !h->slots) return -1;
+	for (i = hash_name(name) & h->slot_mask; h->slots[i];
+			i = (i + 1) & h->slot_mask) {
+		int slot = h->slots[i] - 1;
+		if (streq(h->specs[slot]->name, name))
+			return slot;
+	}
+	return -1;
+}
+
+static void parser_freeold(struct parser *p) {
+	p->cur = NULL;
+	p->nvals = 0;
 }
 
 static bool parse_random(const char *str, random_value *bonus) {
@@ -202,18 +281,188 @@ static bool parse_random(const char *str, random_value *bonus) {
 	return true;
 }
 
+/**
+ * ------------------------------------------------------------------------
+ * Recording and replaying parsed lines
+ *
+ * A recording holds, for each line that reached a hook, the line and column
+ * numbers, the order in which the hook was registered and the values
+ * parsed for it.  Numbers are unsigned 32 bit values stored least significant
+ * byte first and strings are terminated by a zero byte; the types of the
+ * values come from the hook's specs, so a recording can only be replayed by a
+ * parser with the same hooks (see parser_signature()).
+ * ------------------------------------------------------------------------ */
+
+static void record_bytes(struct parser *p, const void *b, size_t n) {
+	if (p->rec_len + n > p->rec_size) {
+		while (p->rec_len + n > p->rec_size)
+			p->rec_size = p->rec_size ? 2 * p->rec_size : 4096;
+		p->rec = mem_realloc(p->rec, p->rec_size);
+	}
+	memcpy(p->rec + p->rec_len, b, n);
+	p->rec_len += n;
+}
+
+static void record_u32(struct parser *p, uint32_t v) {
+	uint8_t b[4];
+
+	b[0] = v & 0xFF;
+	b[1] = (v >> 8) & 0xFF;
+	b[2] = (v >> 16) & 0xFF;
+	b[3] = (v >> 24) & 0xFF;
+	record_bytes(p, b, 4);
+}
+
+static void record_line(struct parser *p) {
+	int i;
+
+	record_u32(p, p->lineno);
+	record_u32(p, p->colno);
+	record_u32(p, p->cur->index);
+	record_u32(p, p->nvals);
+	for (i = 0; i < p->nvals; i++) {
+		struct parser_value *v = &p->vals[i];
+		int t = v->type & ~PARSE_T_OPT;
+
+		if (t == PARSE_T_INT) {
+			record_u32(p, (uint32_t)v->u.ival);
+		} else if (t == PARSE_T_UINT) {
+			record_u32(p, v->u.uval);
+		} else if (t == PARSE_T_CHAR) {
+			record_u32(p, (uint32_t)v->u.cval);
+		} else if (t == PARSE_T_RAND) {
+			record_u32(p, (uint32_t)v->u.rval.base);
+			record_u32(p, (uint32_t)v->u.rval.dice);
+			record_u32(p, (uint32_t)v->u.rval.sides);
+			record_u32(p, (uint32_t)v->u.rval.m_bonus);
+		} else {
+			record_bytes(p, v->u.sval, strlen(v->u.sval) + 1);
+		}
+	}
+}
+
+static bool take_u32(const uint8_t **pos, const uint8_t *end, uint32_t *v) {
+	const uint8_t *b = *pos;
+
+	if (end - b < 4) return false;
+	*v = (uint32_t)b[0] | ((uint32_t)b[1] << 8) | ((uint32_t)b[2] << 16)
+		| ((uint32_t)b[3] << 24);
+	*pos = b + 4;
+	return true;
+}
+
+static bool take_str(const uint8_t **pos, const uint8_t *end, char **s) {
+	const uint8_t *z = memchr(*pos, 0, end - *pos);
+
+	if (!z) return false;
+	*s = (char *)*pos;
+	*pos = z + 1;
+	return true;
+}
+
+/**
+ * Decode one recorded line into the parser's values.  Returns the hook to
+ * run, or NULL if the recording is malformed.
+ */
+static struct parser_hook *replay_decode(struct parser *p,
+		struct parser_hook **hooks, const uint8_t **pos,
+		const uint8_t *end) {
+	uint32_t line, col, idx, n, i, r[4];
+	struct parser_hook *h;
+	struct parser_spec *s;
+
+	if (!take_u32(pos, end, &line) || !take_u32(pos, end, &col)
+			|| !take_u32(pos, end, &idx) || !take_u32(pos, end, &n)
+			|| idx >= p->nhooks || !hooks[idx])
+		return NULL;
+	h = hooks[idx];
+	if (n > (uint32_t)h->nspecs) return NULL;
+	p->lineno = line;
+	p->colno = col;
+	p->cur = h;
+	p->nvals = n;
+
+	for (i = 0; i < n; i++) {
+		struct parser_value *v = &p->vals[i];
+		int t = h->specs[i]->type & ~PARSE_T_OPT;
+
+		v->type = h->specs[i]->type;
+		if (t == PARSE_T_INT) {
+			if (!take_u32(pos, end, &r[0])) return NULL;
+			v->u.ival = (int)r[0];
+		} else if (t == PARSE_T_UINT) {
+			if (!take_u32(pos, end, &v->u.uval)) return NULL;
+		} else if (t == PARSE_T_CHAR) {
+			if (!take_u32(pos, end, &r[0])) return NULL;
+			v->u.cval = (wchar_t)r[0];
+		} else if (t == PARSE_T_RAND) {
+			if (!take_u32(pos, end, &r[0]) || !take_u32(pos, end, &r[1])
+					|| !take_u32(pos, end, &r[2])
+					|| !take_u32(pos, end, &r[3]))
+				return NULL;
+			v->u.rval.base = (int)r[0];
+			v->u.rval.dice = (int)r[1];
+			v->u.rval.sides = (int)r[2];
+			v->u.rval.m_bonus = (int)r[3];
+		} else if (!take_str(pos, end, &v->u.sval)) {
+			return NULL;
+		}
+	}
+
+	/* The values left out must all be optional */
+	s = (n < (uint32_t)h->nspecs) ? h->specs[n] : NULL;
+	if (s && !(s->type & PARSE_T_OPT)) return NULL;
+
+	return h;
+}
+
+/**
+ * Run through a recording, calling the hooks if run is set.  Returns
+ * PARSE_ERROR_INTERNAL if the recording is malformed, otherwise the result
+ * of the last hook run.
+ */
+static enum parser_error replay_lines(struct parser *p, const uint8_t *buf,
+		size_t len, bool run) {
+	const uint8_t *pos = buf, *end = buf + len;
+	struct parser_hook **hooks, *h;
+	enum parser_error r = PARSE_ERROR_NONE;
+
+	/* Only the hooks in use can be named by a recording */
+	parser_freeold(p);
+	hooks = mem_zalloc(MAX(p->nhooks, 1) * sizeof(*hooks));
+	for (h = p->hooks; h; h = h->next) {
+		if (findhook(p, h->dir) == h) hooks[h->index] = h;
+	}
+
+	while (pos < end) {
+		h = replay_decode(p, hooks, &pos, end);
+		if (!h) {
+			r = PARSE_ERROR_INTERNAL;
+			break;
+		}
+		if (run) {
+			r = h->func(p);
+			if (r) break;
+		}
+	}
+
+	/* The string values point into the recording */
+	parser_freeold(p);
+	mem_free(hooks);
+	return r;
+}
+
 /**
  * Parses the provided line.
  *
  * This runs the first parser hook registered with `p` that matches `line`.
  */
 enum parser_error parser_parse(struct parser *p, const char *line) {
-	char *cline;
 	char *tok;
 	struct parser_hook *h;
-	struct parser_spec *s;
-	struct parser_value *v;
+	size_t len;
 	char *sp = NULL;
+	int i;
 
 	assert(p);
 	assert(line);
@@ -222,8 +471,6 @@ enum parser_error parser_parse(struct parser *p, const char *line) {
 
 	p->lineno++;
 	p->colno = 1;
-	p->fhead = NULL;
-	p->ftail = NULL;
 
 	/* Ignore empty lines and comments. */
 	while (*line && (isspace((unsigned char)*line)))
@@ -231,11 +478,16 @@ enum parser_error parser_parse(struct parser *p, const char *line) {
 	if (!*line || *line == '#')
 		return PARSE_ERROR_NONE;
 
-	cline = string_make(line);
+	/* Work on a copy, which the string values point into */
+	len = strlen(line) + 1;
+	if (len > p->line_size) {
+		p->line_size = MAX(len, 2 * p->line_size);
+		p->line = mem_realloc(p->line, p->line_size);
+	}
+	memcpy(p->line, line, len);
 
-	tok = strtok(cline, ":");
+	tok = strtok(p->line, ":");
 	if (!tok) {
-		mem_free(cline);
 		p->error = PARSE_ERROR_MISSING_FIELD;
 		return PARSE_ERROR_MISSING_FIELD;
 	}
@@ -244,7 +496,6 @@ enum parser_error parser_parse(struct parser *p, const char *line) {
 	if (!h) {
 		my_strcpy(p->errmsg, tok, sizeof(p->errmsg));
 		p->error = PARSE_ERROR_UNDEFINED_DIRECTIVE;
-		mem_free(cline);
 		return PARSE_ERROR_UNDEFINED_DIRECTIVE;
 	}
 
@@ -252,7 +503,9 @@ enum parser_error parser_parse(struct parser *p, const char *line) {
 	 * types. The optional flag has a bit assigned to it in the spec's type
 	 * tag; we compute a temporary type for the spec with that flag removed
 	 * and use that instead. */
-	for (s = h->fhead; s; s = s->next) {
+	for (i = 0; i < h->nspecs; i++) {
+		struct parser_spec *s = h->specs[i];
+		struct parser_value *v = &p->vals[i];
 		int t = s->type & ~PARSE_T_OPT;
 		p->colno++;
 
@@ -273,7 +526,6 @@ enum parser_error parser_parse(struct parser *p, const char *line) {
 						my_strcpy(p->errmsg, s->name,
 							sizeof(p->errmsg));
 						p->error = PARSE_ERROR_FIELD_TOO_LONG;
-						mem_free(cline);
 						return PARSE_ERROR_FIELD_TOO_LONG;
 					}
 				}
@@ -286,25 +538,17 @@ enum parser_error parser_parse(struct parser *p, const char *line) {
 			if (!(s->type & PARSE_T_OPT)) {
 				my_strcpy(p->errmsg, s->name, sizeof(p->errmsg));
 				p->error = PARSE_ERROR_MISSING_FIELD;
-				mem_free(cline);
 				return PARSE_ERROR_MISSING_FIELD;
 			}
 			break;
 		}
 
-		/* Allocate a value node. */
-		v = mem_alloc(sizeof *v);
-		v->spec.next = NULL;
-		v->spec.type = s->type;
-		v->spec.name = s->name;
-
 		/* Parse out its value. */
+		v->type = s->type;
 		if (t == PARSE_T_INT) {
 			char *z = NULL;
 			v->u.ival = strtol(tok, &z, 0);
 			if (z == tok) {
-				mem_free(v);
-				mem_free(cline);
 				my_strcpy(p->errmsg, s->name, sizeof(p->errmsg));
 				p->error = PARSE_ERROR_NOT_NUMBER;
 				return PARSE_ERROR_NOT_NUMBER;
@@ -313,8 +557,6 @@ enum parser_error parser_parse(struct parser *p, const char *line) {
 			char *z = NULL;
 			v->u.uval = strtoul(tok, &z, 0);
 			if (z == tok || *tok == '-') {
-				mem_free(v);
-				mem_free(cline);
 				my_strcpy(p->errmsg, s->name, sizeof(p->errmsg));
 				p->error = PARSE_ERROR_NOT_NUMBER;
 				return PARSE_ERROR_NOT_NUMBER;
@@ -322,31 +564,90 @@ enum parser_error parser_parse(struct parser *p, const char *line) {
 		} else if (t == PARSE_T_CHAR) {
 			text_mbstowcs(&v->u.cval, tok, 1);
 		} else if (t == PARSE_T_SYM || t == PARSE_T_STR) {
-			v->u.sval = string_make(tok);
+			v->u.sval = tok;
 		} else if (t == PARSE_T_RAND) {
 			if (!parse_random(tok, &v->u.rval)) {
-				mem_free(v);
-				mem_free(cline);
 				my_strcpy(p->errmsg, s->name, sizeof(p->errmsg));
 				p->error = PARSE_ERROR_NOT_RANDOM;
 				return PARSE_ERROR_NOT_RANDOM;
 			}
 		}
-
-		/* Link it into the value list. */
-		if (!p->fhead)
-			p->fhead = v;
-		else
-			p->ftail->spec.next = &v->spec;
-		p->ftail = v;
 	}
+	p->cur = h;
+	p->nvals = i;
 
-	mem_free(cline);
+	if (p->recording) record_line(p);
 
 	p->error = h->func(p);
 	return p->error;
 }
 
+/**
+ * Starts recording the lines given to parser_parse(), discarding any earlier
+ * recording, or stops recording and keeps what was recorded.
+ */
+void parser_record(struct parser *p, bool on) {
+	if (on) p->rec_len = 0;
+	p->recording = on;
+}
+
+/**
+ * Returns what has been recorded since parser_record() and its length in
+ * len.  The recording belongs to the parser.
+ */
+const uint8_t *parser_recording(struct parser *p, size_t *len) {
+	*len = p->rec_len;
+	return p->rec;
+}
+
+/**
+ * Returns whether buf holds a whole recording that this parser can replay,
+ * without running any hooks.
+ */
+bool parser_replay_check(struct parser *p, const uint8_t *buf, size_t len) {
+	unsigned int line = p->lineno, col = p->colno;
+	bool valid = replay_lines(p, buf, len, false) == PARSE_ERROR_NONE;
+
+	p->lineno = line;
+	p->colno = col;
+	return valid;
+}
+
+/**
+ * Runs the hooks for each line of a recording, as parser_parse() would have
+ * for the lines recorded.  The recording should have been checked with
+ * parser_replay_check().  Returns the first error from a hook.
+ */
+enum parser_error parser_replay(struct parser *p, const uint8_t *buf,
+		size_t len) {
+	p->error = replay_lines(p, buf, len, true);
+	return p->error;
+}
+
+/**
+ * Returns a hash of the parser's hooks and their specs, which changes if
+ * any directive is added, removed or given different fields.
+ */
+uint64_t parser_signature(struct parser *p) {
+	uint64_t hash = 0xcbf29ce484222325ULL;
+	struct parser_hook *h;
+	struct parser_spec *s;
+	const char *c;
+
+	for (h = p->hooks; h; h = h->next) {
+		for (c = h->dir; *c; c++)
+			hash = (hash ^ (uint8_t)*c) * 0x100000001b3ULL;
+		for (s = h->fhead; s; s = s->next) {
+			hash = (hash ^ (uint8_t)s->type) * 0x100000001b3ULL;
+			for (c = s->name; *c; c++)
+				hash = (hash ^ (uint8_t)*c) * 0x100000001b3ULL;
+			hash = (hash ^ ' ') * 0x100000001b3ULL;
+		}
+		hash = (hash ^ '\n') * 0x100000001b3ULL;
+	}
+	return hash;
+}
+
 /**
  * Gets parser's private data.
  */
@@ -393,6 +694,8 @@ static void clean_specs(struct parser_hook *h) {
 		mem_free((void*)s->name);
 		mem_free(s);
 	}
+	mem_free(h->specs);
+	mem_free(h->slots);
 }
 
 /**
@@ -401,6 +704,10 @@ static void clean_specs(struct parser_hook *h) {
 void parser_destroy(struct parser *p) {
 	struct parser_hook *h;
 	parser_freeold(p);
+	mem_free(p->rec);
+	mem_free(p->line);
+	mem_free(p->vals);
+	mem_free(p->table);
 	while (p->hooks) {
 		h = p->hooks->next;
 		clean_specs(p->hooks);
@@ -470,6 +777,35 @@ static errr parse_specs(struct parser_hook *h, char *fmt) {
 	return 0;
 }
 
+/**
+ * Index the specs of a new hook by slot and by name.
+ */
+static void index_specs(struct parser_hook *h) {
+	struct parser_spec *s;
+	uint32_t size = 4;
+	int i;
+
+	h->nspecs = 0;
+	for (s = h->fhead; s; s = s->next)
+		h->nspecs++;
+	assert(h->nspecs < 255);
+	h->specs = mem_zalloc(MAX(h->nspecs, 1) * sizeof(*h->specs));
+	while (size < 2 * (uint32_t)h->nspecs) size *= 2;
+	h->slots = mem_zalloc(size);
+	h->slot_mask = size - 1;
+
+	for (i = 0, s = h->fhead; s; s = s->next, i++) {
+		h->specs[i] = s;
+
+		/* The first of any specs with the same name gets the value */
+		if (hook_slot(h, s->name) < 0) {
+			uint32_t j = hash_name(s->name) & h->slot_mask;
+			while (h->slots[j]) j = (j + 1) & h->slot_mask;
+			h->slots[j] = i + 1;
+		}
+	}
+}
+
 /**
  * Registers a parser hook.
  *
@@ -492,7 +828,7 @@ errr parser_reg(struct parser *p, const char *fmt,
 	assert(fmt);
 	assert(func);
 
-	h = mem_alloc(sizeof *h);
+	h = mem_zalloc(sizeof *h);
 	cfmt = string_make(fmt);
 	h->next = p->hooks;
 	h->func = func;
@@ -504,8 +840,17 @@ errr parser_reg(struct parser *p, const char *fmt,
 		return r;
 	}
 
-	p->hooks = h;
 	mem_free(cfmt);
+	index_specs(h);
+	h->hash = hash_name(h->dir);
+	h->index = p->nhooks++;
+	if (h->nspecs > p->max_vals) {
+		p->max_vals = h->nspecs;
+		p->vals = mem_realloc(p->vals, p->max_vals * sizeof(*p->vals));
+	}
+	p->hooks = h;
+	table_grow(p);
+	table_insert(p, h);
 	return 0;
 }
 
@@ -522,21 +867,14 @@ enum parser_error ignored(struct parser *p) {
  * Used to test for presence of optional values.
  */
 bool parser_hasval(struct parser *p, const char *name) {
-	struct parser_value *v;
-	for (v = p->fhead; v; v = (struct parser_value *)v->spec.next) {
-		if (streq(v->spec.name, name))
-			return true;
-	}
-	return false;
+	int slot = hook_slot(p->cur, name);
+	return slot >= 0 && slot < p->nvals;
 }
 
 static struct parser_value *parser_getval(struct parser *p, const char *name) {
-	struct parser_value *v;
-	for (v = p->fhead; v; v = (struct parser_value *)v->spec.next) {
-		if (streq(v->spec.name, name)) {
-			return v;
-		}
-	}
+	int slot = hook_slot(p->cur, name);
+	if (slot >= 0 && slot < p->nvals)
+		return &p->vals[slot];
 	quit_fmt("parser_getval error: name is %s\n", name);
 	return 0; /* Needed to avoid Windows compiler warning */
 }
@@ -546,7 +884,7 @@ static struct parser_value *parser_getval(struct parser *p, const char *name) {
  */
 const char *parser_getsym(struct parser *p, const char *name) {
 	struct parser_value *v = parser_getval(p, name);
-	assert((v->spec.type & ~PARSE_T_OPT) == PARSE_T_SYM);
+	assert((v->type & ~PARSE_T_OPT) == PARSE_T_SYM);
 	return v->u.sval;
 }
 
@@ -555,7 +893,7 @@ const char *parser_getsym(struct parser *p, const char *name) {
  */
 int parser_getint(struct parser *p, const char *name) {
 	struct parser_value *v = parser_getval(p, name);
-	assert((v->spec.type & ~PARSE_T_OPT) == PARSE_T_INT);
+	assert((v->type & ~PARSE_T_OPT) == PARSE_T_INT);
 	return v->u.ival;
 }
 
@@ -564,7 +902,7 @@ int parser_getint(struct parser *p, const char *name) {
  */
 unsigned int parser_getuint(struct parser *p, const char *name) {
 	struct parser_value *v = parser_getval(p, name);
-	assert((v->spec.type & ~PARSE_T_OPT) == PARSE_T_UINT);
+	assert((v->type & ~PARSE_T_OPT) == PARSE_T_UINT);
 	return v->u.uval;
 }
 
@@ -573,7 +911,7 @@ unsigned int parser_getuint(struct parser *p, const char *name) {
  */
 const char *parser_getstr(struct parser *p, const char *name) {
 	struct parser_value *v = parser_getval(p, name);
-	assert((v->spec.type & ~PARSE_T_OPT) == PARSE_T_STR);
+	assert((v->type & ~PARSE_T_OPT) == PARSE_T_STR);
 	return v->u.sval;
 }
 
@@ -582,7 +920,7 @@ const char *parser_getstr(struct parser *p, const char *name) {
  */
 struct random parser_getrand(struct parser *p, const char *name) {
 	struct parser_value *v = parser_getval(p, name);
-	assert((v->spec.type & ~PARSE_T_OPT) == PARSE_T_RAND);
+	assert((v->type & ~PARSE_T_OPT) == PARSE_T_RAND);
 	return v->u.rval;
 }
 
@@ -591,7 +929,7 @@ struct random parser_getrand(struct parser *p, const char *name) {
  */
 wchar_t parser_getchar(struct parser *p, const char *name) {
 	struct parser_value *v = parser_getval(p, name);
-	assert((v->spec.type & ~PARSE_T_OPT) == PARSE_T_CHAR);
+	assert((v->type & ~PARSE_T_OPT) == PARSE_T_CHAR);
 	return v->u.cval;
 }
 
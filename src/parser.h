@@ -64,5 +64,12 @@ extern struct random parser_getrand(struct parser *p, const char *name);
 extern wchar_t parser_getchar(struct parser *p, const char *name);
 extern int parser_getstate(struct parser *p, struct parser_state *s);
 extern void parser_setstate(struct parser *p, unsigned int col, const char *msg);
+extern void parser_record(struct parser *p, bool on);
+extern const uint8_t *parser_recording(struct parser *p, size_t *len);
+extern bool parser_replay_check(struct parser *p, const uint8_t *buf,
+		size_t len);
+extern enum parser_error parser_replay(struct parser *p, const uint8_t *buf,
+		size_t len);
+extern uint64_t parser_signature(struct parser *p);
 
 #endif /* !PARSER_H */
@@ -21,8 +21,10 @@
 #include "cmds.h"
 #include "game-event.h"
 #include "game-world.h"
+#include "generate.h"
 #include "init.h"
 #include "mon-lore.h"
+#include "mon-make.h"
 #include "monster.h"
 #include "obj-curse.h"
 #include "obj-gear.h"
@@ -427,6 +429,7 @@ void player_init(struct player *p)
 		lore->pkills = 0;
 		lore->thefts = 0;
 	}
+	invalidate_mon_num_tables();
 
 	p->upkeep = mem_zalloc(sizeof(struct player_upkeep));
 	p->upkeep->inven = mem_zalloc((z_info->pack_size + 1) *
@@ -1268,7 +1271,7 @@ void do_cmd_accept_character(struct command *cmd)
 
 	/* Initialise the stores, dungeon */
 	store_reset();
-	chunk_list_max = 0;
+	chunk_list_free();
 
 	/* Player learns innate runes */
 	player_learn_innate(player);
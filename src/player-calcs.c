@@ -2687,8 +2687,14 @@ void redraw_stuff(struct player *p)
 	if (!character_generated) return;
 
 	/* Map is not shown, subwindow updates only */
-	if (!map_is_visible()) 
-		redraw &= PR_SUBWINDOW;
+	if (!map_is_visible()) redraw &= PR_SUBWINDOW;
+
+	/*
+	 * Draw the grids which have changed, even while running; when the map
+	 * is not shown, that is only in the subwindows
+	 */
+	if (cave && cave_redraw_pending(cave) && !(redraw & PR_MAP))
+		event_signal(EVENT_MAP);
 
 	/* Hack - rarely update while resting or running, makes it over quicker */
 	if (((player_resting_count(p) % 100) || (p->upkeep->running % 100))
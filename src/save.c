@@ -19,10 +19,12 @@
 #include "angband.h"
 #include "cave.h"
 #include "game-world.h"
+#include "generate.h"
 #include "init.h"
 #include "mon-group.h"
 #include "mon-lore.h"
 #include "mon-make.h"
+#include "mon-move.h"
 #include "monster.h"
 #include "object.h"
 #include "obj-desc.h"
@@ -133,8 +135,7 @@ static void wr_item(const struct object *obj)
 	}
 	wr_byte(obj->notice);
 
-	for (i = 0; i < OF_SIZE; i++)
-		wr_byte(obj->flags[i]);
+	wr_bytes(obj->flags, OF_SIZE);
 
 	for (i = 0; i < OBJ_MOD_MAX; i++) {
 		wr_s16b(obj->modifiers[i]);
@@ -225,11 +226,9 @@ static void wr_monster(const struct monster *mon)
 	for (j = 0; j < MON_TMD_MAX; j++)
 		wr_s16b(mon->m_timed[j]);
 
-	for (j = 0; j < MFLAG_SIZE; j++)
-		wr_byte(mon->mflag[j]);
+	wr_bytes(mon->mflag, MFLAG_SIZE);
 
-	for (j = 0; j < OF_SIZE; j++)
-		wr_byte(mon->known_pstate.flags[j]);
+	wr_bytes(mon->known_pstate.flags, OF_SIZE);
 
 	for (j = 0; j < ELEM_MAX; j++)
 		wr_s16b(mon->known_pstate.el_info[j].res_level);
@@ -260,8 +259,6 @@ static void wr_monster(const struct monster *mon)
  */
 static void wr_trap(struct trap *trap)
 {
-	size_t i;
-
 	if (trap->t_idx) {
 		wr_string(trap_info[trap->t_idx].desc);
 	} else {
@@ -272,8 +269,7 @@ static void wr_trap(struct trap *trap)
 	wr_byte(trap->power);
 	wr_byte(trap->timeout);
 
-	for (i = 0; i < TRF_SIZE; i++)
-		wr_byte(trap->flags[i]);
+	wr_bytes(trap->flags, TRF_SIZE);
 }
 
 /**
@@ -377,6 +373,7 @@ void wr_monster_memory(void)
 void wr_object_memory(void)
 {
 	int k_idx;
+	uint8_t *known;
 
 	wr_u16b(z_info->k_max);
 	wr_byte(OF_SIZE);
@@ -387,18 +384,18 @@ void wr_object_memory(void)
 	wr_byte(z_info->curse_max);
 
 	/* Kind knowledge */
+	known = mem_zalloc(z_info->k_max);
 	for (k_idx = 0; k_idx < z_info->k_max; k_idx++) {
-		uint8_t tmp8u = 0;
 		struct object_kind *kind = &k_info[k_idx];
 
-		if (kind->aware) tmp8u |= 0x01;
-		if (kind->tried) tmp8u |= 0x02;
-		if (kind_is_ignored_aware(kind)) tmp8u |= 0x04;
-		if (kind->everseen) tmp8u |= 0x08;
-		if (kind_is_ignored_unaware(kind)) tmp8u |= 0x10;
-
-		wr_byte(tmp8u);
+		if (kind->aware) known[k_idx] |= 0x01;
+		if (kind->tried) known[k_idx] |= 0x02;
+		if (kind_is_ignored_aware(kind)) known[k_idx] |= 0x04;
+		if (kind->everseen) known[k_idx] |= 0x08;
+		if (kind_is_ignored_unaware(kind)) known[k_idx] |= 0x10;
 	}
+	wr_bytes(known, z_info->k_max);
+	mem_free(known);
 }
 
 
@@ -632,8 +629,7 @@ void wr_misc(void)
 	//	return;
 
 	/* Flags */
-	for (i = 0; i < OF_SIZE; i++)
-		wr_byte(player->obj_k->flags[i]);
+	wr_bytes(player->obj_k->flags, OF_SIZE);
 
 	/* Modifiers */
 	for (i = 0; i < OBJ_MOD_MAX; i++) {
@@ -766,6 +762,38 @@ void wr_stores(void)
 
 
 
+/**
+ * Run length encode the `n` bytes in `bytes` as (count, byte) pairs into
+ * `runs`, which must have room for 2 * n + 2 bytes; return the length of the
+ * encoding.  A run that doesn't start with a zero byte is preceded by an empty
+ * run of zeroes, as the loader expects.
+ */
+static size_t rle_encode(const uint8_t *bytes, size_t n, uint8_t *runs)
+{
+	size_t i, len = 0;
+	uint8_t count = 0;
+	uint8_t prev_char = 0;
+
+	for (i = 0; i < n; i++) {
+		/* If the run is broken, or too full, flush it */
+		if ((bytes[i] != prev_char) || (count == UCHAR_MAX)) {
+			runs[len++] = count;
+			runs[len++] = prev_char;
+			prev_char = bytes[i];
+			count = 1;
+		} else /* Continue the run */
+			count++;
+	}
+
+	/* Flush the data (if any) */
+	if (count) {
+		runs[len++] = count;
+		runs[len++] = prev_char;
+	}
+
+	return len;
+}
+
 /**
  * Write the current dungeon terrain features and info flags
  *
@@ -774,12 +802,9 @@ void wr_stores(void)
 static void wr_dungeon_aux(struct chunk *c)
 {
 	int y, x;
-	size_t i;
-
-	uint8_t tmp8u;
-
-	uint8_t count;
-	uint8_t prev_char;
+	size_t i, n = (size_t)c->height * c->width;
+	uint8_t *layer = mem_alloc(MAX(n, 1));
+	uint8_t *runs = mem_alloc(2 * n + 2);
 
 	/* Dungeon specific info follows */
 	wr_string(c->name ? c->name : "Blank");
@@ -788,59 +813,22 @@ static void wr_dungeon_aux(struct chunk *c)
 
 	/* Run length encoding of c->squares[y][x].info */
 	for (i = 0; i < SQUARE_SIZE; i++) {
-		count = 0;
-		prev_char = 0;
-
-		/* Dump for each grid */
-		for (y = 0; y < c->height; y++) {
-			for (x = 0; x < c->width; x++) {
-				/* Extract the important c->squares[y][x].info flags */
-				tmp8u = square(c, loc(x, y))->info[i];
-
-				/* If the run is broken, or too full, flush it */
-				if ((tmp8u != prev_char) || (count == UCHAR_MAX)) {
-					wr_byte(count);
-					wr_byte(prev_char);
-					prev_char = tmp8u;
-					count = 1;
-				} else /* Continue the run */
-					count++;
-			}
-		}
+		/* Extract the important c->squares[y][x].info flags */
+		for (y = 0; y < c->height; y++)
+			for (x = 0; x < c->width; x++)
+				layer[y * c->width + x] = square(c, loc(x, y))->info[i];
 
-		/* Flush the data (if any) */
-		if (count) {
-			wr_byte(count);
-			wr_byte(prev_char);
-		}
+		wr_bytes(runs, rle_encode(layer, n, runs));
 	}
 
 	/* Now the terrain */
-	count = 0;
-	prev_char = 0;
-
-	/* Dump for each grid */
-	for (y = 0; y < c->height; y++) {
-		for (x = 0; x < c->width; x++) {
-			/* Extract a byte */
-			tmp8u = square(c, loc(x, y))->feat;
-
-			/* If the run is broken, or too full, flush it */
-			if ((tmp8u != prev_char) || (count == UCHAR_MAX)) {
-				wr_byte(count);
-				wr_byte(prev_char);
-				prev_char = tmp8u;
-				count = 1;
-			} else /* Continue the run */
-				count++;
-		}
-	}
+	for (y = 0; y < c->height; y++)
+		for (x = 0; x < c->width; x++)
+			layer[y * c->width + x] = square(c, loc(x, y))->feat;
+	wr_bytes(runs, rle_encode(layer, n, runs));
 
-	/* Flush the data (if any) */
-	if (count) {
-		wr_byte(count);
-		wr_byte(prev_char);
-	}
+	mem_free(runs);
+	mem_free(layer);
 
 	/* Write feeling */
 	wr_byte(c->feeling);
@@ -985,6 +973,9 @@ void wr_objects(void)
 
 void wr_monsters(void)
 {
+	/* Write energy back from the turn order */
+	monsters_sync_energy(cave);
+
 	wr_monsters_aux(cave);
 	wr_monsters_aux(player->cave);
 }
@@ -995,6 +986,43 @@ void wr_traps(void)
 	wr_traps_aux(player->cave);
 }
 
+/**
+ * Write a stored chunk
+ */
+void wr_chunk(struct chunk *c)
+{
+	/* Write the terrain and info */
+	wr_dungeon_aux(c);
+
+	/* Write the objects */
+	wr_objects_aux(c);
+
+	/* Write the monsters */
+	wr_monsters_aux(c);
+
+	/* Write the traps */
+	wr_traps_aux(c);
+
+	/* Write other chunk info */
+	if (OPT(player, birth_levels_persist)) {
+		int i;
+
+		wr_string(c->name);
+		wr_s32b(c->turn);
+		wr_u16b(c->depth);
+		wr_byte(c->feeling);
+		wr_u32b(c->obj_rating);
+		wr_u32b(c->mon_rating);
+		wr_byte(c->good_item ? 1 : 0);
+		wr_u16b(c->height);
+		wr_u16b(c->width);
+		wr_u16b(c->feeling_squares);
+		for (i = 0; i < FEAT_MAX + 1; i++) {
+			wr_u16b(c->feat_count[i]);
+		}
+	}
+}
+
 /*
  * Write the chunk list
  */
@@ -1011,35 +1039,14 @@ void wr_chunks(void)
 	for (j = 0; j < chunk_list_max; j++) {
 		struct chunk *c = chunk_list[j];
 
-		/* Write the terrain and info */
-		wr_dungeon_aux(c);
-
-		/* Write the objects */
-		wr_objects_aux(c);
-
-		/* Write the monsters */
-		wr_monsters_aux(c);
-
-		/* Write the traps */
-		wr_traps_aux(c);
-
-		/* Write other chunk info */
-		if (OPT(player, birth_levels_persist)) {
-			int i;
-
-			wr_string(c->name);
-			wr_s32b(c->turn);
-			wr_u16b(c->depth);
-			wr_byte(c->feeling);
-			wr_u32b(c->obj_rating);
-			wr_u32b(c->mon_rating);
-			wr_byte(c->good_item ? 1 : 0);
-			wr_u16b(c->height);
-			wr_u16b(c->width);
-			wr_u16b(c->feeling_squares);
-			for (i = 0; i < FEAT_MAX + 1; i++) {
-				wr_u16b(c->feat_count[i]);
-			}
+		if (c->pack) {
+			/* Packed chunks are already written */
+			uint32_t size;
+			const uint8_t *data = chunk_pack_data(c, &size);
+
+			wr_bytes(data, size);
+		} else {
+			wr_chunk(c);
 		}
 	}
 }
@@ -1047,7 +1054,7 @@ void wr_chunks(void)
 
 void wr_history(void)
 {
-	size_t i, j;
+	size_t i;
 
 	struct history_info *history_list;
 	uint32_t length = history_get_list(player, &history_list);
@@ -1055,8 +1062,7 @@ void wr_history(void)
 	wr_byte(HIST_SIZE);
 	wr_u32b(length);
 	for (i = 0; i < length; i++) {
-		for (j = 0; j < HIST_SIZE; j++)
-			wr_byte(history_list[i].type[j]);
+		wr_bytes(history_list[i].type, HIST_SIZE);
 		wr_s32b(history_list[i].turn);
 		wr_s16b(history_list[i].dlev);
 		wr_s16b(history_list[i].clev);
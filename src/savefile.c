@@ -23,6 +23,16 @@
 #include "save-charoutput.h"
 #include "z-file.h"
 
+/**
+ * Builds with threads write background saves from a thread of their own.
+ * Not for setgid builds, which switch the group of the whole process to get
+ * at the savefiles and so can't have that going on beside the game.
+ */
+#if defined(USE_SAVE_THREAD) && !defined(SETGID)
+#define SAVE_THREAD
+#include <pthread.h>
+#endif
+
 /**
  * The savefile code.
  *
@@ -155,14 +165,58 @@ static const struct blockinfo loaders[] = {
 };
 
 
-/* Buffer bits */
+/**
+ * A savefile held in memory, and how far through it the loader is
+ */
+struct savefile_image {
+	uint8_t *data;
+	uint32_t size;
+	uint32_t pos;
+};
+
+/**
+ * Buffer bits
+ *
+ * When saving, buffer is a fixed size staging area which is written out to
+ * save_file, or to the end of save_image if there is no file, whenever it
+ * fills; save_block_size counts what has been written of the current block.
+ * When loading, buffer points at the current block in the image of the whole
+ * savefile.
+ */
 static uint8_t *buffer;
 static uint32_t buffer_size;
 static uint32_t buffer_pos;
 static uint32_t buffer_check;
 
-#define BUFFER_INITIAL_SIZE		1024
-#define BUFFER_BLOCK_INCREMENT	1024
+static ang_file *save_file;
+static struct savefile_image *save_image;
+static uint32_t save_image_alloc;
+static uint32_t save_block_size;
+static bool save_ok;
+
+/**
+ * A save taken by savefile_save_background() which may still be being written
+ */
+static struct {
+	char path[1024];
+	char new_path[1024];
+	char old_path[1024];
+	struct savefile_image image;
+	bool pending;
+	bool ok;
+#ifdef SAVE_THREAD
+	bool threaded;
+	pthread_t thread;
+	/* Set by the writer, under save_job_lock, when it has finished */
+	bool done;
+#endif
+} save_job;
+
+#ifdef SAVE_THREAD
+static pthread_mutex_t save_job_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+#define SAVE_BUFFER_SIZE		65536
 
 #define SAVEFILE_HEAD_SIZE		28
 
@@ -187,23 +241,91 @@ void note(const char *message)
  * Base put/get
  * ------------------------------------------------------------------------ */
 
+/**
+ * Add n bytes to the end of the savefile being written
+ */
+static bool save_write(const void *data, uint32_t n)
+{
+	if (save_file) return file_write(save_file, data, n);
+
+	while (save_image_alloc - save_image->size < n) {
+		save_image_alloc *= 2;
+		save_image->data = mem_realloc(save_image->data, save_image_alloc);
+	}
+	memcpy(save_image->data + save_image->size, data, n);
+	save_image->size += n;
+	return true;
+}
+
+/**
+ * Return how much of the savefile has been written, or -1 on error
+ */
+static long save_tell(void)
+{
+	return save_file ? file_tell(save_file) : (long)save_image->size;
+}
+
+/**
+ * Overwrite n bytes of what has already been written, starting at pos
+ */
+static bool save_patch(long pos, const uint8_t *data, uint32_t n)
+{
+	long end;
+
+	if (!save_file) {
+		memcpy(save_image->data + pos, data, n);
+		return true;
+	}
+
+	end = file_tell(save_file);
+	return end >= 0 && file_seek(save_file, pos)
+		&& file_write(save_file, (const char *)data, n)
+		&& file_seek(save_file, end);
+}
+
+/**
+ * Write out what is in the staging buffer
+ */
+static void sf_flush(void)
+{
+	if (buffer_pos && !save_write(buffer, buffer_pos))
+		save_ok = false;
+	save_block_size += buffer_pos;
+	buffer_pos = 0;
+}
+
 static void sf_put(uint8_t v)
 {
 	assert(buffer != NULL);
 	assert(buffer_size > 0);
 
 	if (buffer_size == buffer_pos)
-	{
-		buffer_size += BUFFER_BLOCK_INCREMENT;
-		buffer = mem_realloc(buffer, buffer_size);
-	}
-
-	assert(buffer_pos < buffer_size);
+		sf_flush();
 
 	buffer[buffer_pos++] = v;
 	buffer_check += v;
 }
 
+static void sf_put_bytes(const uint8_t *v, size_t n)
+{
+	assert(buffer != NULL);
+	assert(buffer_size > 0);
+
+	while (n) {
+		size_t len = MIN(n, buffer_size - buffer_pos), i;
+
+		for (i = 0; i < len; i++)
+			buffer_check += v[i];
+		memcpy(buffer + buffer_pos, v, len);
+		buffer_pos += len;
+		v += len;
+		n -= len;
+
+		if (buffer_size == buffer_pos)
+			sf_flush();
+	}
+}
+
 static uint8_t sf_get(void)
 {
 	if ((buffer == NULL) || (buffer_size <= 0) || (buffer_pos >= buffer_size))
@@ -214,6 +336,24 @@ static uint8_t sf_get(void)
 	return buffer[buffer_pos++];
 }
 
+/**
+ * Return the next n bytes of the block, or quit if there are not that many
+ */
+static const uint8_t *sf_get_bytes(size_t n)
+{
+	const uint8_t *v;
+	size_t i;
+
+	if ((buffer == NULL) || (n > buffer_size - buffer_pos))
+		quit("Broken savefile - probably from a development version");
+
+	v = buffer + buffer_pos;
+	for (i = 0; i < n; i++)
+		buffer_check += v[i];
+	buffer_pos += n;
+	return v;
+}
+
 
 /**
  * ------------------------------------------------------------------------
@@ -251,12 +391,12 @@ void wr_s32b(int32_t v)
 
 void wr_string(const char *str)
 {
-	while (*str)
-	{
-		wr_byte(*str);
-		str++;
-	}
-	wr_byte(*str);
+	sf_put_bytes((const uint8_t *)str, strlen(str) + 1);
+}
+
+void wr_bytes(const uint8_t *v, size_t n)
+{
+	sf_put_bytes(v, n);
 }
 
 
@@ -291,23 +431,28 @@ void rd_s32b(int32_t *ip)
 
 void rd_string(char *str, int max)
 {
-	uint8_t tmp8u;
-	int i = 0;
-
-	do {
-		rd_byte(&tmp8u);
+	const uint8_t *end = NULL;
+	size_t len;
 
-		if (i < max) str[i] = tmp8u;
-		if (!tmp8u) break;
-	} while (++i);
+	if (buffer && buffer_pos < buffer_size)
+		end = memchr(buffer + buffer_pos, 0, buffer_size - buffer_pos);
+	if (!end)
+		quit("Broken savefile - probably from a development version");
 
+	/* Take the whole string, keeping as much as fits */
+	len = end - (buffer + buffer_pos) + 1;
+	memcpy(str, sf_get_bytes(len), MIN(len, (size_t)max));
 	str[max - 1] = '\0';
 }
 
+void rd_bytes(uint8_t *v, size_t n)
+{
+	memcpy(v, sf_get_bytes(n), n);
+}
+
 void strip_bytes(int n)
 {
-	uint8_t tmp8u;
-	while (n--) rd_byte(&tmp8u);
+	if (n > 0) sf_get_bytes(n);
 }
 
 void pad_bytes(int n)
@@ -322,21 +467,40 @@ void pad_bytes(int n)
  * ------------------------------------------------------------------------ */
 
 
-static bool try_save(ang_file *file)
+/**
+ * Write the savefile to file, or to the end of im if file is NULL
+ */
+static bool try_save(ang_file *file, struct savefile_image *im)
 {
 	uint8_t savefile_head[SAVEFILE_HEAD_SIZE];
 	size_t i, pos;
-	bool success = true;
 
 	/* Start off the buffer */
-	buffer = mem_alloc(BUFFER_INITIAL_SIZE);
-	buffer_size = BUFFER_INITIAL_SIZE;
+	buffer = mem_alloc(SAVE_BUFFER_SIZE);
+	buffer_size = SAVE_BUFFER_SIZE;
+	save_file = file;
+	save_image = im;
+	save_ok = save_write(savefile_magic, 4) && save_write(savefile_name, 4);
+
+	for (i = 0; save_ok && i < N_ELEMENTS(savers); i++) {
+		long start = save_tell();
+
+		/*
+		 * Leave room for the header, which needs the size and checksum
+		 * of the block, and come back to it when the block is written
+		 */
+		memset(savefile_head, 0, SAVEFILE_HEAD_SIZE);
+		if (start < 0 || !save_write(savefile_head, SAVEFILE_HEAD_SIZE)) {
+			save_ok = false;
+			break;
+		}
 
-	for (i = 0; i < N_ELEMENTS(savers); i++) {
 		buffer_pos = 0;
 		buffer_check = 0;
+		save_block_size = 0;
 
 		savers[i].save();
+		sf_flush();
 
 		/* 16-byte block name */
 		pos = my_strcpy((char *)savefile_head,
@@ -352,30 +516,108 @@ static bool try_save(ang_file *file)
 		savefile_head[pos++] = ((v >> 24) & 0xFF);
 
 		SAVE_U32B(savers[i].version);
-		SAVE_U32B(buffer_pos);
+		SAVE_U32B(save_block_size);
 		SAVE_U32B(buffer_check);
 
 		assert(pos == SAVEFILE_HEAD_SIZE);
 
-		if (! file_write(file, (char *)savefile_head,
-				SAVEFILE_HEAD_SIZE)) {
-			success = false;
-		}
-		if (! file_write(file, (char *)buffer, buffer_pos)) {
-			success = false;
+		if (!save_patch(start, savefile_head, SAVEFILE_HEAD_SIZE)) {
+			save_ok = false;
+			break;
 		}
 
 		/* pad to 4 byte multiples */
-		if (buffer_pos % 4) {
-			if (! file_write(file, "xxx", 4 - (buffer_pos % 4))) {
-				success = false;
+		if (save_block_size % 4) {
+			if (!save_write("xxx", 4 - (save_block_size % 4))) {
+				save_ok = false;
 			}
 		}
 	}
 
 	mem_free(buffer);
+	buffer = NULL;
+	save_file = NULL;
+	save_image = NULL;
+
+	return save_ok;
+}
+
+/**
+ * Put the newly written savefile in place of the one at path, keeping the
+ * old one until that has been done
+ */
+static bool replace_savefile(const char *path, const char *new_savefile,
+		const char *old_savefile)
+{
+	bool err = false;
+
+	safe_setuid_grab();
+
+	if (file_exists(path) && !file_move(path, old_savefile))
+		err = true;
+
+	if (!err) {
+		if (!file_move(new_savefile, path))
+			err = true;
+
+		if (err)
+			file_move(old_savefile, path);
+		else
+			file_delete(old_savefile);
+	}
+
+	safe_setuid_drop();
+
+	return err ? false : true;
+}
+
+/**
+ * Pick the names of the files to write the new save to and to move the old
+ * one to.  That draws on the simple RNG, so it is only done by the main thread.
+ */
+static void get_savefile_names(const char *path, char *new_savefile,
+		char *old_savefile, size_t len)
+{
+	safe_setuid_grab();
+	file_get_savefile(old_savefile, len, path, "old");
+	file_get_savefile(new_savefile, len, path, "new");
+	safe_setuid_drop();
+}
+
+/**
+ * Write a savefile, either from the game or from an image of it, to path by
+ * way of the new and old files named.
+ */
+static bool write_savefile(const char *path, const char *new_savefile,
+		const char *old_savefile, struct savefile_image *im)
+{
+	ang_file *file;
+	bool ok;
+
+	/* Open the savefile */
+	safe_setuid_grab();
+	file = file_open(new_savefile, MODE_WRITE, FTYPE_SAVE);
+	safe_setuid_drop();
+
+	if (!file) return false;
+
+	if (im) {
+		ok = file_write(file, (char *)im->data, im->size);
+	} else {
+		ok = try_save(file, NULL);
+	}
+
+	/* Make sure it is all on disk before it replaces the old savefile */
+	if (!file_sync(file)) ok = false;
+	if (!file_close(file)) ok = false;
+
+	if (ok) return replace_savefile(path, new_savefile, old_savefile);
 
-	return success;
+	/* Delete temp file if the save failed */
+	safe_setuid_grab();
+	file_delete(new_savefile);
+	safe_setuid_drop();
+	return false;
 }
 
 /**
@@ -383,69 +625,172 @@ static bool try_save(ang_file *file)
  */
 bool savefile_save(const char *path)
 {
-	ang_file *file;
 	char new_savefile[1024];
 	char old_savefile[1024];
 
+	/* Don't let a save still being written go over this one */
+	(void) savefile_wait();
+
 	/* Generate a CharOutput.txt, mainly for angband.live, when saving. */
 	(void) save_charoutput();
 
-	/* New savefile */
-	safe_setuid_grab();
-	file_get_savefile(old_savefile, sizeof(old_savefile), path, "old");
+	get_savefile_names(path, new_savefile, old_savefile,
+		sizeof(new_savefile));
+	character_saved = write_savefile(path, new_savefile, old_savefile, NULL);
+	return character_saved;
+}
 
-	/* Open the savefile */
-        file_get_savefile(new_savefile, sizeof(new_savefile), path, "new");
+/**
+ * Write out the save held by save_job
+ */
+static void *write_save_job(void *unused)
+{
+	save_job.ok = write_savefile(save_job.path, save_job.new_path,
+		save_job.old_path, &save_job.image);
+#ifdef SAVE_THREAD
+	pthread_mutex_lock(&save_job_lock);
+	save_job.done = true;
+	pthread_mutex_unlock(&save_job_lock);
+#endif
+	return NULL;
+}
 
-	file = file_open(new_savefile, MODE_WRITE, FTYPE_SAVE);
-	safe_setuid_drop();
+/**
+ * Save the player in a savefile, writing it while play carries on
+ */
+bool savefile_save_background(const char *path)
+{
+	/* Only one save is written at a time */
+	(void) savefile_wait();
 
-	if (file) {
-		if (file_write(file, (char *) &savefile_magic, 4)
-			&& file_write(file, (char *) &savefile_name, 4)) {
-			character_saved = try_save(file);
-		} else {
-			character_saved = false;
-		}
-		file_close(file);
-	} else {
+	/* Generate a CharOutput.txt, mainly for angband.live, when saving. */
+	(void) save_charoutput();
+
+	/* Take the game as it is now */
+	save_image_alloc = SAVE_BUFFER_SIZE;
+	save_job.image.data = mem_alloc(save_image_alloc);
+	save_job.image.size = 0;
+	save_job.image.pos = 0;
+	if (!try_save(NULL, &save_job.image)) {
+		mem_free(save_job.image.data);
+		save_job.image.data = NULL;
 		character_saved = false;
+		return false;
 	}
+	character_saved = true;
+
+	my_strcpy(save_job.path, path, sizeof(save_job.path));
+	get_savefile_names(path, save_job.new_path, save_job.old_path,
+		sizeof(save_job.new_path));
+	save_job.pending = true;
+
+#ifdef SAVE_THREAD
+	save_job.done = false;
+	save_job.threaded = (pthread_create(&save_job.thread, NULL,
+		write_save_job, NULL) == 0);
+	if (save_job.threaded) return true;
+#endif
+
+	/* Write it now if it can't be done beside the game */
+	(void) write_save_job(NULL);
+	return true;
+}
 
-	if (character_saved) {
-		bool err = false;
+/**
+ * Wait for the save taken by savefile_save_background() to be written
+ */
+bool savefile_wait(void)
+{
+	if (!save_job.pending) return true;
 
-		safe_setuid_grab();
+#ifdef SAVE_THREAD
+	if (save_job.threaded) {
+		pthread_join(save_job.thread, NULL);
+		save_job.threaded = false;
+	}
+#endif
+	save_job.pending = false;
+	mem_free(save_job.image.data);
+	save_job.image.data = NULL;
+
+	/* A failure means the game as it was then isn't saved */
+	if (!save_job.ok) character_saved = false;
+	return save_job.ok;
+}
 
-		if (file_exists(path) && !file_move(path, old_savefile))
-			err = true;
+/**
+ * See if the save taken by savefile_save_background() has been written,
+ * without waiting for it
+ */
+bool savefile_poll(bool *written)
+{
+	if (!save_job.pending) return false;
 
-		if (!err) {
-			if (!file_move(new_savefile, path))
-				err = true;
+#ifdef SAVE_THREAD
+	if (save_job.threaded) {
+		bool done;
 
-			if (err)
-				file_move(old_savefile, path);
-			else
-				file_delete(old_savefile);
-		} 
+		pthread_mutex_lock(&save_job_lock);
+		done = save_job.done;
+		pthread_mutex_unlock(&save_job_lock);
+		if (!done) return false;
+	}
+#endif
+	*written = savefile_wait();
+	return true;
+}
 
-		safe_setuid_drop();
 
-		return err ? false : true;
-	}
 
-	/* Delete temp file if the save failed */
-	if (file) {
-		/* File is no longer valid, but it still points to a non zero
-		 * value if the file was created above */
-		safe_setuid_grab();
-		file_delete(new_savefile);
-		safe_setuid_drop();
-	}
-	return false;
+/**
+ * Pack a stored chunk into memory, as wr_chunks() would write it
+ */
+uint8_t *savefile_pack_chunk(struct chunk *c, uint32_t *size)
+{
+	struct savefile_image im;
+
+	/* Start off the buffer */
+	buffer = mem_alloc(SAVE_BUFFER_SIZE);
+	buffer_size = SAVE_BUFFER_SIZE;
+	buffer_pos = 0;
+	buffer_check = 0;
+	save_block_size = 0;
+	save_image_alloc = SAVE_BUFFER_SIZE;
+	im.data = mem_alloc(save_image_alloc);
+	im.size = 0;
+	im.pos = 0;
+	save_image = &im;
+	save_ok = true;
+
+	wr_chunk(c);
+	sf_flush();
+
+	mem_free(buffer);
+	buffer = NULL;
+	save_image = NULL;
+
+	*size = im.size;
+	return mem_realloc(im.data, MAX(im.size, 1));
 }
 
+/**
+ * Make a chunk from what savefile_pack_chunk() wrote
+ */
+struct chunk *savefile_unpack_chunk(const uint8_t *data, uint32_t size)
+{
+	struct chunk *c = NULL;
+
+	buffer = (uint8_t *)data;
+	buffer_size = size;
+	buffer_pos = 0;
+	buffer_check = 0;
+
+	if (rd_packed_chunk(&c) || buffer_pos != size)
+		quit("Broken stored level");
+
+	buffer = NULL;
+	return c;
+}
 
 
 /**
@@ -453,13 +798,56 @@ bool savefile_save(const char *path)
  * Savefile loading functions
  * ------------------------------------------------------------------------ */
 
+/**
+ * Read the whole of the file at `path` into `im`; false if it can't be opened
+ */
+static bool image_read(const char *path, struct savefile_image *im)
+{
+	ang_file *f;
+	uint32_t alloc = SAVE_BUFFER_SIZE;
+	int len;
+
+	safe_setuid_grab();
+	f = file_open(path, MODE_READ, FTYPE_TEXT);
+	safe_setuid_drop();
+	if (!f) return false;
+
+	im->data = mem_alloc(alloc);
+	im->size = 0;
+	im->pos = 0;
+	while ((len = file_read(f, (char *)im->data + im->size,
+			alloc - im->size)) > 0) {
+		im->size += len;
+		if (im->size == alloc) {
+			alloc *= 2;
+			im->data = mem_realloc(im->data, alloc);
+		}
+	}
+
+	file_close(f);
+	return true;
+}
+
+/**
+ * Return the next `n` bytes of the image, or NULL if there are not that many
+ */
+static uint8_t *image_take(struct savefile_image *im, uint32_t n)
+{
+	uint8_t *data;
+
+	if (n > im->size - im->pos) return NULL;
+	data = im->data + im->pos;
+	im->pos += n;
+	return data;
+}
+
 /**
  * Check the savefile header file clearly inicates that it's a savefile
  */
-static bool check_header(ang_file *f) {
-	uint8_t head[8];
+static bool check_header(struct savefile_image *im) {
+	const uint8_t *head = image_take(im, 8);
 
-	if (file_read(f, (char *) &head, 8) == 8 &&
+	if (head &&
 			memcmp(&head[0], savefile_magic, 4) == 0 &&
 			memcmp(&head[4], savefile_name, 4) == 0)
 		return true;
@@ -470,15 +858,14 @@ static bool check_header(ang_file *f) {
 /**
  * Get the next block header from the savefile
  */
-static errr next_blockheader(ang_file *f, struct blockheader *b) {
-	uint8_t savefile_head[SAVEFILE_HEAD_SIZE];
-	size_t len;
+static errr next_blockheader(struct savefile_image *im, struct blockheader *b) {
+	const uint8_t *savefile_head;
 
-	len = file_read(f, (char *)savefile_head, SAVEFILE_HEAD_SIZE);
-	if (len == 0) /* no more blocks */
+	if (im->pos == im->size) /* no more blocks */
 		return 1;
 
-	if (len != SAVEFILE_HEAD_SIZE || savefile_head[15] != 0) {
+	savefile_head = image_take(im, SAVEFILE_HEAD_SIZE);
+	if (!savefile_head || savefile_head[15] != 0) {
 		return -1;
 	}
 
@@ -488,7 +875,7 @@ static errr next_blockheader(ang_file *f, struct blockheader *b) {
 	((uint32_t) savefile_head[from+2] << 16) | \
 	((uint32_t) savefile_head[from+3] << 24);
 
-	my_strcpy(b->name, (char *)&savefile_head, sizeof b->name);
+	my_strcpy(b->name, (const char *)savefile_head, sizeof b->name);
 	b->version = RECONSTRUCT_U32B(16);
 	b->size = RECONSTRUCT_U32B(20);
 
@@ -521,47 +908,47 @@ static loader_t find_loader(struct blockheader *b,
 /**
  * Load a given block with the given loader
  */
-static bool load_block(ang_file *f, struct blockheader *b, loader_t loader)
+static bool load_block(struct savefile_image *im, struct blockheader *b,
+		loader_t loader)
 {
-	/* Allocate space for the buffer */
-	buffer = mem_alloc(b->size);
+	bool ok;
+
+	/* The loader reads the block where it is in the image */
+	buffer = image_take(im, b->size);
+	buffer_size = b->size;
 	buffer_pos = 0;
 	buffer_check = 0;
 
-	buffer_size = file_read(f, (char *) buffer, b->size);
-	if (buffer_size != b->size ||
-			loader() != 0) {
-		mem_free(buffer);
-		return false;
-	}
-
-	mem_free(buffer);
-	return true;
+	ok = (buffer != NULL && loader() == 0);
+	buffer = NULL;
+	return ok;
 }
 
 /**
  * Skip a block
  */
-static void skip_block(ang_file *f, struct blockheader *b)
+static void skip_block(struct savefile_image *im, struct blockheader *b)
 {
-	file_skip(f, b->size);
+	if (!image_take(im, b->size))
+		im->pos = im->size;
 }
 
 /**
  * Try to load a savefile
  */
-static bool try_load(ang_file *f, const struct blockinfo *local_loaders)
+static bool try_load(struct savefile_image *im,
+		const struct blockinfo *local_loaders)
 {
 	struct blockheader b;
 	errr err;
 
-	if (!check_header(f)) {
+	if (!check_header(im)) {
 		note("Savefile is corrupted -- incorrect file header.");
 		return false;
 	}
 
 	/* Get the next block header */
-	while ((err = next_blockheader(f, &b)) == 0) {
+	while ((err = next_blockheader(im, &b)) == 0) {
 		loader_t loader = find_loader(&b, local_loaders);
 		if (!loader) {
 			note("Savefile block can't be read.");
@@ -569,7 +956,7 @@ static bool try_load(ang_file *f, const struct blockinfo *local_loaders)
 			return false;
 		}
 
-		if (!load_block(f, &b, loader)) {
+		if (!load_block(im, &b, loader)) {
 			note(format("Savefile corrupted - Couldn't load block %s", b.name));
 			return false;
 		}
@@ -596,30 +983,27 @@ static int get_desc(void) {
  */
 const char *savefile_get_description(const char *path) {
 	struct blockheader b;
-	ang_file *f;
+	struct savefile_image im;
 
-	safe_setuid_grab();
-	f = file_open(path, MODE_READ, FTYPE_TEXT);
-	safe_setuid_drop();
-	if (!f) return NULL;
+	if (!image_read(path, &im)) return NULL;
 
 	/* Blank the description */
 	savefile_desc[0] = 0;
 
-	if (!check_header(f)) {
+	if (!check_header(&im)) {
 		my_strcpy(savefile_desc, "Invalid savefile", sizeof savefile_desc);
 	} else {
-		while (!next_blockheader(f, &b)) {
+		while (!next_blockheader(&im, &b)) {
 			if (!streq(b.name, "description")) {
-				skip_block(f, &b);
+				skip_block(&im, &b);
 				continue;
 			}
-			load_block(f, &b, get_desc);
+			load_block(&im, &b, get_desc);
 			break;
 		}
 	}
 
-	file_close(f);
+	mem_free(im.data);
 	return savefile_desc;
 }
 
@@ -630,18 +1014,18 @@ const char *savefile_get_description(const char *path) {
 bool savefile_load(const char *path, bool cheat_death)
 {
 	bool ok;
-	ang_file *f;
+	struct savefile_image im;
 
-	safe_setuid_grab();
-	f = file_open(path, MODE_READ, FTYPE_TEXT);
-	safe_setuid_drop();
-	if (!f) {
+	/* Don't read a savefile which is still being written */
+	(void) savefile_wait();
+
+	if (!image_read(path, &im)) {
 		note("Couldn't open savefile.");
 		return false;
 	}
 
-	ok = try_load(f, loaders);
-	file_close(f);
+	ok = try_load(&im, loaders);
+	mem_free(im.data);
 
 	if (player->is_dead && cheat_death) {
 			player->is_dead = false;
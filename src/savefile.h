@@ -22,6 +22,8 @@
 #define ITEM_VERSION	5
 #define EGO_ART_KNOWN 0xffffffff
 
+struct chunk;
+
 /**
  * ------------------------------------------------------------------------
  * Savefile API
@@ -37,6 +39,27 @@ extern bool character_saved;
  */
 bool savefile_save(const char *path);
 
+/**
+ * Save to the given location, taking the state of the game now but leaving
+ * the file to be written while play carries on where that is possible.
+ * Returns false if the state of the game couldn't be taken; the result of
+ * writing the file comes from savefile_wait().
+ */
+bool savefile_save_background(const char *path);
+
+/**
+ * Wait for a save from savefile_save_background() to be written.  Returns
+ * false if that failed, true if it succeeded or there was nothing to wait for.
+ */
+bool savefile_wait(void);
+
+/**
+ * Finish off a save from savefile_save_background() if it has been written,
+ * without waiting.  Returns true, with whether it was written successfully
+ * in written, if it has; false if it is still being written or there was none.
+ */
+bool savefile_poll(bool *written);
+
 /**
  * Load the savefile given.  Returns true on succcess, false otherwise.
  */
@@ -47,6 +70,18 @@ bool savefile_load(const char *path, bool cheat_death);
  */
 const char *savefile_get_description(const char *path);
 
+/**
+ * Pack a stored chunk into memory in the form it takes in a savefile.
+ * Returns the bytes, to be freed with mem_free(), and sets size to how many
+ * there are.
+ */
+uint8_t *savefile_pack_chunk(struct chunk *c, uint32_t *size);
+
+/**
+ * Make a chunk again from what savefile_pack_chunk() gave.
+ */
+struct chunk *savefile_unpack_chunk(const uint8_t *data, uint32_t size);
+
 /**
  * Fill the given buffer with the panic save equivalent for a savefile.
  */
@@ -69,6 +104,7 @@ void wr_s16b(int16_t v);
 void wr_u32b(uint32_t v);
 void wr_s32b(int32_t v);
 void wr_string(const char *str);
+void wr_bytes(const uint8_t *v, size_t n);
 void pad_bytes(int n);
 
 /* Reading bits */
@@ -78,6 +114,7 @@ void rd_s16b(int16_t *ip);
 void rd_u32b(uint32_t *ip);
 void rd_s32b(int32_t *ip);
 void rd_string(char *str, int max);
+void rd_bytes(uint8_t *v, size_t n);
 void strip_bytes(int n);
 
 
@@ -99,6 +136,7 @@ int rd_gear(void);
 int rd_stores(void);
 int rd_dungeon(void);
 int rd_chunks(void);
+int rd_packed_chunk(struct chunk **c);
 int rd_objects(void);
 int rd_monsters(void);
 int rd_monster_groups(void);
@@ -125,6 +163,7 @@ void wr_gear(void);
 void wr_stores(void);
 void wr_dungeon(void);
 void wr_chunks(void);
+void wr_chunk(struct chunk *c);
 void wr_objects(void);
 void wr_monsters(void);
 void wr_monster_groups(void);
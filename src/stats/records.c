@@ -0,0 +1,383 @@
+/**
+ * \file stats/records.c
+ * \brief Stream of per-level records from the stats front end
+ *
+ * This work is free software; you can redistribute it and/or modify it
+ * under the terms of either:
+ *
+ * a) the GNU General Public License as published by the Free Software
+ *    Foundation, version 2, or
+ *
+ * b) the "Angband licence":
+ *    This software may be copied and distributed for educational,
+ *    research,
+ *    and not for profit purposes provided that this copyright and
+ *    statement
+ *    are included in all such copies.  Other copyrights may also apply.
+ */
+
+#include "angband.h"
+#include "stats/db.h"
+#include "stats/records.h"
+
+/**
+ * The file starts with a header:
+ *     4 bytes      magic, "ASLR"
+ *     4 bytes      format version
+ *     4 bytes      number of fields, n
+ *     n strings    the field names, each terminated by a zero byte
+ * and then holds records of n fields each.  All numbers are unsigned 32 bit
+ * values stored least significant byte first.
+ */
+#define RECORDS_MAGIC		"ASLR"
+#define RECORDS_VERSION		1
+#define RECORDS_NAME_LEN	32
+#define RECORDS_BUF_SIZE	65536
+
+/**
+ * Field names, which are also the column names in the level_records table
+ */
+static const char *field_names[SREC_MAX] = {
+	"run",
+	"level",
+	"feeling",
+	"objects",
+	"gold",
+	"artifacts",
+	"egos",
+	"wearables",
+	"consumables",
+	"monsters",
+	"uniques"
+};
+
+/**
+ * Module state variables
+ */
+static ang_file *records_file;
+static uint8_t *records_buf;
+static size_t records_len;
+
+/**
+ * Utility functions
+ */
+static void put_u32(uint8_t *p, uint32_t v)
+{
+	p[0] = v & 0xFF;
+	p[1] = (v >> 8) & 0xFF;
+	p[2] = (v >> 16) & 0xFF;
+	p[3] = (v >> 24) & 0xFF;
+}
+
+static uint32_t get_u32(const uint8_t *p)
+{
+	return (uint32_t)p[0] | ((uint32_t)p[1] << 8)
+		| ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static bool read_u32(ang_file *f, uint32_t *v)
+{
+	uint8_t b[4];
+
+	if (file_read(f, (char *)b, 4) != 4) return false;
+	*v = get_u32(b);
+	return true;
+}
+
+static bool write_header(ang_file *f)
+{
+	uint8_t b[12];
+	int i;
+
+	memcpy(b, RECORDS_MAGIC, 4);
+	put_u32(b + 4, RECORDS_VERSION);
+	put_u32(b + 8, SREC_MAX);
+	if (!file_write(f, (const char *)b, sizeof(b))) return false;
+	for (i = 0; i < SREC_MAX; i++) {
+		if (!file_write(f, field_names[i], strlen(field_names[i]) + 1))
+			return false;
+	}
+	return true;
+}
+
+/**
+ * Read the header, putting the index of each stored field into our list of
+ * fields into map.  Returns the number of stored fields, or -1 if the header
+ * is bad or names a field we don't know.
+ */
+static int read_header(ang_file *f, int map[SREC_MAX])
+{
+	char magic[4];
+	uint32_t version, n;
+	int i;
+
+	if (file_read(f, magic, 4) != 4 || memcmp(magic, RECORDS_MAGIC, 4)
+			|| !read_u32(f, &version) || version != RECORDS_VERSION
+			|| !read_u32(f, &n) || n == 0 || n > SREC_MAX)
+		return -1;
+
+	for (i = 0; i < (int)n; i++) {
+		char name[RECORDS_NAME_LEN];
+		size_t len = 0;
+		uint8_t c;
+		int j;
+
+		do {
+			if (!file_readc(f, &c) || len == sizeof(name))
+				return -1;
+			name[len++] = c;
+		} while (c);
+
+		for (j = 0; j < SREC_MAX; j++) {
+			if (streq(name, field_names[j])) break;
+		}
+		if (j == SREC_MAX) return -1;
+		map[i] = j;
+	}
+
+	return n;
+}
+
+static bool records_flush(void)
+{
+	bool ok = file_write(records_file, (const char *)records_buf,
+		records_len);
+
+	records_len = 0;
+	return ok;
+}
+
+/**
+ * Read the records after the header, passing each block of whole records to
+ * func, which may be NULL.  Returns the number of bytes in a partial record
+ * at the end of the file, or -1 on failure.
+ */
+static int read_records(ang_file *f, size_t rec_size,
+		bool (*func)(void *, const uint8_t *, size_t), void *ctx)
+{
+	size_t size = RECORDS_BUF_SIZE - RECORDS_BUF_SIZE % rec_size;
+	uint8_t *buf = mem_alloc(size);
+	int got, tail = 0;
+
+	while ((got = file_read(f, (char *)buf, size)) > 0) {
+		size_t whole = got - got % rec_size;
+
+		if (func && whole && !func(ctx, buf, whole)) {
+			got = -1;
+			break;
+		}
+		tail = got % rec_size;
+	}
+	mem_free(buf);
+
+	return (got < 0) ? -1 : tail;
+}
+
+static bool copy_records(void *ctx, const uint8_t *buf, size_t len)
+{
+	return file_write((ang_file *)ctx, (const char *)buf, len);
+}
+
+/**
+ * Rewrite the file at path without the partial record left at the end by an
+ * interrupted write, so new records can follow on.
+ */
+static bool drop_partial_record(const char *path)
+{
+	char new_path[1024];
+	int map[SREC_MAX];
+	ang_file *from, *to;
+	bool ok;
+
+	strnfmt(new_path, sizeof(new_path), "%s.new", path);
+	from = file_open(path, MODE_READ, FTYPE_RAW);
+	if (!from) return false;
+	to = file_open(new_path, MODE_WRITE, FTYPE_RAW);
+	if (!to) {
+		file_close(from);
+		return false;
+	}
+
+	ok = read_header(from, map) == SREC_MAX && write_header(to)
+		&& read_records(from, SREC_MAX * 4, copy_records, to) >= 0;
+	file_close(from);
+	if (!file_close(to)) ok = false;
+
+	return ok && file_delete(path) && file_move(new_path, path);
+}
+
+/**
+ * ------------------------------------------------------------------------
+ *  Interface functions
+ * ------------------------------------------------------------------------ */
+
+/**
+ * Start writing records to the file at path.  If append is set and the file
+ * already holds records, new ones go on the end; the existing file must then
+ * have the same fields as we write.  Returns true on success.
+ */
+bool stats_records_open(const char *path, bool append)
+{
+	bool has_header = false;
+
+	if (append && file_exists(path)) {
+		ang_file *f = file_open(path, MODE_READ, FTYPE_RAW);
+		int map[SREC_MAX], n, i, tail;
+
+		if (!f) return false;
+		n = read_header(f, map);
+		tail = (n == SREC_MAX) ? read_records(f, SREC_MAX * 4, NULL, NULL)
+			: -1;
+		file_close(f);
+		if (tail < 0) return false;
+		for (i = 0; i < n; i++) {
+			if (map[i] != i) return false;
+		}
+		if (tail && !drop_partial_record(path)) return false;
+		has_header = true;
+	}
+
+	records_file = file_open(path, append ? MODE_APPEND : MODE_WRITE,
+		FTYPE_RAW);
+	if (!records_file) return false;
+	if (!has_header && !write_header(records_file)) {
+		file_close(records_file);
+		records_file = NULL;
+		return false;
+	}
+
+	records_buf = mem_alloc(RECORDS_BUF_SIZE);
+	records_len = 0;
+	return true;
+}
+
+/**
+ * Add a record of SREC_MAX fields.  Records are collected in memory and
+ * written out in large blocks.
+ */
+bool stats_records_add(const uint32_t *record)
+{
+	int i;
+
+	if (records_len + SREC_MAX * 4 > RECORDS_BUF_SIZE && !records_flush())
+		return false;
+	for (i = 0; i < SREC_MAX; i++) {
+		put_u32(records_buf + records_len, record[i]);
+		records_len += 4;
+	}
+	return true;
+}
+
+/**
+ * Write out any records still held, so they survive the job being killed.
+ */
+bool stats_records_sync(void)
+{
+	if (!records_file) return true;
+	return records_flush() && file_flush(records_file);
+}
+
+/**
+ * Write out any records still held and close the file.
+ */
+bool stats_records_close(void)
+{
+	bool ok;
+
+	if (!records_file) return true;
+	ok = records_flush();
+	if (!file_close(records_file)) ok = false;
+	records_file = NULL;
+	mem_free(records_buf);
+	records_buf = NULL;
+	return ok;
+}
+
+/**
+ * Create the table the records are loaded into.  The database must be open.
+ * Returns zero on success or a sqlite3 error code.
+ */
+int stats_records_prep_db(void)
+{
+	char sql_buf[512];
+	int i;
+
+	my_strcpy(sql_buf, "CREATE TABLE level_records(", sizeof(sql_buf));
+	for (i = 0; i < SREC_MAX; i++) {
+		my_strcat(sql_buf, field_names[i], sizeof(sql_buf));
+		my_strcat(sql_buf, " INT, ", sizeof(sql_buf));
+	}
+	my_strcat(sql_buf, "UNIQUE (run, level) ON CONFLICT REPLACE);",
+		sizeof(sql_buf));
+	return stats_db_exec(sql_buf);
+}
+
+struct insert_context {
+	sqlite3_stmt *stmt;
+	int n;
+};
+
+static bool insert_records(void *ctx, const uint8_t *buf, size_t len)
+{
+	struct insert_context *ic = ctx;
+	const uint8_t *p;
+	int i;
+
+	for (p = buf; p < buf + len; p += ic->n * 4) {
+		for (i = 0; i < ic->n; i++) {
+			if (sqlite3_bind_int64(ic->stmt, i + 1, get_u32(p + 4 * i)))
+				return false;
+		}
+		if (sqlite3_step(ic->stmt) != SQLITE_DONE
+				|| sqlite3_reset(ic->stmt))
+			return false;
+	}
+	return true;
+}
+
+/**
+ * Load the records in the file at path into the level_records table of the
+ * open database.  A run that was made again after resuming from a
+ * checkpoint replaces the earlier copy.  Returns true on success.
+ */
+bool stats_records_load(const char *path)
+{
+	char sql_buf[512];
+	int map[SREC_MAX], n, i;
+	struct insert_context ctx;
+	ang_file *f;
+	bool ok;
+
+	f = file_open(path, MODE_READ, FTYPE_RAW);
+	if (!f) return false;
+	n = read_header(f, map);
+	if (n < 0) {
+		file_close(f);
+		return false;
+	}
+
+	/* Only the fields the file has get values */
+	my_strcpy(sql_buf, "INSERT INTO level_records(", sizeof(sql_buf));
+	for (i = 0; i < n; i++) {
+		my_strcat(sql_buf, field_names[map[i]], sizeof(sql_buf));
+		my_strcat(sql_buf, (i < n - 1) ? ", " : ") VALUES(",
+			sizeof(sql_buf));
+	}
+	for (i = 0; i < n; i++)
+		my_strcat(sql_buf, (i < n - 1) ? "?, " : "?);", sizeof(sql_buf));
+
+	if (stats_db_exec("BEGIN TRANSACTION;")
+			|| stats_db_stmt_prep(&ctx.stmt, sql_buf)) {
+		file_close(f);
+		return false;
+	}
+	ctx.n = n;
+
+	/* A partial record at the end is from an interrupted write */
+	ok = read_records(f, n * 4, insert_records, &ctx) >= 0;
+	file_close(f);
+
+	if (sqlite3_finalize(ctx.stmt)) ok = false;
+	if (stats_db_exec(ok ? "COMMIT;" : "ROLLBACK;")) ok = false;
+	return ok;
+}
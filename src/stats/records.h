@@ -0,0 +1,49 @@
+/**
+ * \file stats/records.h
+ * Purpose: stream of per-level records from the stats front end
+ *
+ * This work is free software; you can redistribute it and/or modify it
+ * under the terms of either:
+ *
+ * a) the GNU General Public License as published by the Free Software
+ *    Foundation, version 2, or
+ *
+ * b) the "Angband licence":
+ *    This software may be copied and distributed for educational,
+ *    research,
+ *    and not for profit purposes provided that this copyright and
+ *    statement
+ *    are included in all such copies.  Other copyrights may also apply.
+ */
+
+#ifndef STATS_RECORDS_H
+#define STATS_RECORDS_H
+
+/**
+ * Fields of a level record, in the order they are stored.  The file header
+ * names the fields, so new ones can go on the end without breaking the
+ * loading of older files.
+ */
+enum stats_record_field {
+	SREC_RUN,		/* Run number */
+	SREC_LEVEL,		/* Dungeon level */
+	SREC_FEELING,		/* Level feeling, as cave->feeling */
+	SREC_OBJECTS,		/* Objects on the floor or carried */
+	SREC_GOLD,		/* Total value of the gold */
+	SREC_ARTIFACTS,		/* Artifacts */
+	SREC_EGOS,		/* Ego items */
+	SREC_WEARABLES,		/* Objects of variable power */
+	SREC_CONSUMABLES,	/* Other objects */
+	SREC_MONSTERS,		/* Monsters killed */
+	SREC_UNIQUES,		/* Uniques killed */
+	SREC_MAX
+};
+
+extern bool stats_records_open(const char *path, bool append);
+extern bool stats_records_add(const uint32_t *record);
+extern bool stats_records_sync(void);
+extern bool stats_records_close(void);
+extern int stats_records_prep_db(void);
+extern bool stats_records_load(const char *path);
+
+#endif /* STATS_RECORDS_H */
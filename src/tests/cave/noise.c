@@ -0,0 +1,158 @@
+/*
+ * cave/noise
+ * Test the incremental upkeep of the noise map.
+ */
+
+#include "unit-test.h"
+#include "test-utils.h"
+#include "cave.h"
+#include "init.h"
+
+int setup_tests(void **state) {
+	set_file_paths();
+	if (!init_angband()) {
+		return 1;
+	}
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	cleanup_angband();
+	return 0;
+}
+
+/*
+ * Build a level split in two by a wall, with rubble blocking a gap in the wall
+ * and a short dead end corridor off the right half.
+ */
+static struct chunk *create_split_cave(void) {
+	struct chunk *c = cave_new(9, 15);
+	struct loc grid;
+
+	for (grid.y = 0; grid.y < c->height; ++grid.y) {
+		for (grid.x = 0; grid.x < c->width; ++grid.x) {
+			if (grid.y == 0 || grid.y == c->height - 1 || grid.x == 0
+					|| grid.x == c->width - 1) {
+				square_set_feat(c, grid, FEAT_PERM);
+			} else if (grid.x == 7 || grid.y > 5) {
+				square_set_feat(c, grid, FEAT_GRANITE);
+			} else {
+				square_set_feat(c, grid, FEAT_FLOOR);
+			}
+		}
+	}
+	square_set_feat(c, loc(7, 2), FEAT_RUBBLE);
+	square_set_feat(c, loc(11, 6), FEAT_FLOOR);
+	return c;
+}
+
+static bool noise_maps_match(struct chunk *c1, struct chunk *c2) {
+	struct loc grid;
+
+	for (grid.y = 0; grid.y < c1->height; ++grid.y) {
+		for (grid.x = 0; grid.x < c1->width; ++grid.x) {
+			if (c1->noise.grids[grid.y][grid.x] !=
+					c2->noise.grids[grid.y][grid.x]) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+/* Rebuild from scratch a copy of the level to compare with */
+static bool noise_matches_rebuild(struct chunk *c, struct loc origin,
+		int increment, void (*change)(struct chunk *c)) {
+	struct chunk *ref = create_split_cave();
+	bool result;
+
+	if (change) change(ref);
+	cave_update_noise(ref, origin, increment);
+	result = noise_maps_match(c, ref);
+	cave_free(ref);
+	return result;
+}
+
+static void clear_rubble(struct chunk *c) {
+	square_set_feat(c, loc(7, 2), FEAT_FLOOR);
+}
+
+static void clear_rubble_and_tunnel(struct chunk *c) {
+	clear_rubble(c);
+	square_set_feat(c, loc(7, 4), FEAT_FLOOR);
+}
+
+static int test_noise_basic(void *state) {
+	struct chunk *c = create_split_cave();
+
+	cave_update_noise(c, loc(2, 2), 1);
+	eq(c->noise.grids[2][2], 0);
+	eq(c->noise.grids[2][3], 1);
+	eq(c->noise.grids[4][6], 4);
+	/* Nothing gets past the rubble or into the walls */
+	eq(c->noise.grids[2][7], 0);
+	eq(c->noise.grids[2][8], 0);
+	eq(c->noise.grids[6][2], 0);
+
+	/* Louder steps go up faster */
+	cave_update_noise(c, loc(2, 2), 4);
+	eq(c->noise.grids[4][6], 16);
+	cave_free(c);
+	ok;
+}
+
+static int test_noise_open(void *state) {
+	struct chunk *c = create_split_cave();
+
+	cave_update_noise(c, loc(2, 2), 1);
+	clear_rubble(c);
+	cave_update_noise(c, loc(2, 2), 1);
+	eq(c->noise.grids[2][7], 5);
+	eq(c->noise.grids[6][11], 9);
+	require(noise_matches_rebuild(c, loc(2, 2), 1, clear_rubble));
+
+	/* A shortcut through the wall makes the far side quieter */
+	square_set_feat(c, loc(7, 4), FEAT_FLOOR);
+	cave_update_noise(c, loc(2, 2), 1);
+	eq(c->noise.grids[4][8], 6);
+	require(noise_matches_rebuild(c, loc(2, 2), 1,
+		clear_rubble_and_tunnel));
+	cave_free(c);
+	ok;
+}
+
+static int test_noise_close(void *state) {
+	struct chunk *c = create_split_cave();
+
+	clear_rubble(c);
+	cave_update_noise(c, loc(2, 2), 1);
+	eq(c->noise.grids[4][8], 7);
+	square_set_feat(c, loc(7, 2), FEAT_RUBBLE);
+	cave_update_noise(c, loc(2, 2), 1);
+	eq(c->noise.grids[4][8], 0);
+	require(noise_matches_rebuild(c, loc(2, 2), 1, NULL));
+	cave_free(c);
+	ok;
+}
+
+static int test_noise_move(void *state) {
+	struct chunk *c = create_split_cave();
+
+	clear_rubble(c);
+	cave_update_noise(c, loc(2, 2), 1);
+	cave_update_noise(c, loc(12, 4), 1);
+	eq(c->noise.grids[4][12], 0);
+	eq(c->noise.grids[2][2], 10);
+	require(noise_matches_rebuild(c, loc(12, 4), 1, clear_rubble));
+	cave_free(c);
+	ok;
+}
+
+const char *suite_name = "cave/noise";
+struct test tests[] = {
+	{ "noise basic", test_noise_basic },
+	{ "noise open", test_noise_open },
+	{ "noise close", test_noise_close },
+	{ "noise move", test_noise_move },
+	{ NULL, NULL }
+};
@@ -0,0 +1,163 @@
+/*
+ * cave/redraw
+ * Test marking grids for the UI to redraw.
+ */
+
+#include "unit-test.h"
+#include "test-utils.h"
+#include "cave.h"
+#include "game-event.h"
+#include "game-input.h"
+#include "game-world.h"
+#include "generate.h"
+#include "init.h"
+#include "mon-make.h"
+#include "player-birth.h"
+#include "player-calcs.h"
+
+static int map_signals;
+
+int setup_tests(void **state) {
+	set_file_paths();
+	if (!init_angband()) {
+		return 1;
+	}
+#ifdef UNIX
+	/* Necessary for creating the randart file. */
+	create_needed_dirs();
+#endif
+
+	/* A level for the player, as well as one to mark */
+	if (!player_make_simple(NULL, NULL, "Tester")) {
+		cleanup_angband();
+		return 1;
+	}
+	prepare_next_level(player);
+	on_new_level();
+
+	*state = cave_new(13, 37);
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	cave_free(state);
+	wipe_mon_list(cave, player);
+	cleanup_angband();
+	return 0;
+}
+
+static bool map_hidden(void) {
+	return false;
+}
+
+/* Stand in for the UI: draw the marked grids, so forget them */
+static void draw_marked(game_event_type type, game_event_data *data,
+		void *user) {
+	if (!data) {
+		++map_signals;
+		cave_clear_redraw(cave);
+	}
+}
+
+static int count_marked(struct chunk *c) {
+	struct loc grid;
+	int n = 0;
+
+	for (grid.y = 0; grid.y < c->height; ++grid.y) {
+		for (grid.x = 0; grid.x < c->width; ++grid.x) {
+			if (square_isredraw(c, grid)) ++n;
+		}
+	}
+	return n;
+}
+
+static int test_mark(void *state) {
+	struct chunk *c = state;
+
+	require(!cave_redraw_pending(c));
+	eq(count_marked(c), 0);
+
+	/* Marking a grid more than once is the same as marking it once */
+	square_mark_redraw(c, loc(5, 3));
+	square_mark_redraw(c, loc(5, 3));
+	require(cave_redraw_pending(c));
+	require(square_isredraw(c, loc(5, 3)));
+	eq(count_marked(c), 1);
+	eq(c->redraw_tl.x, 5);
+	eq(c->redraw_tl.y, 3);
+	eq(c->redraw_br.x, 5);
+	eq(c->redraw_br.y, 3);
+
+	/* The area marked takes in each grid */
+	square_mark_redraw(c, loc(36, 2));
+	square_mark_redraw(c, loc(0, 12));
+	eq(count_marked(c), 3);
+	eq(c->redraw_tl.x, 0);
+	eq(c->redraw_tl.y, 2);
+	eq(c->redraw_br.x, 36);
+	eq(c->redraw_br.y, 12);
+	ok;
+}
+
+static int test_clear(void *state) {
+	struct chunk *c = state;
+	struct loc grid;
+
+	cave_clear_redraw(c);
+	require(!cave_redraw_pending(c));
+	eq(count_marked(c), 0);
+
+	/* Every grid, then none */
+	for (grid.y = 0; grid.y < c->height; ++grid.y) {
+		for (grid.x = 0; grid.x < c->width; ++grid.x) {
+			square_mark_redraw(c, grid);
+		}
+	}
+	eq(count_marked(c), c->height * c->width);
+	cave_clear_redraw(c);
+	eq(count_marked(c), 0);
+
+	/* A single grid at the end */
+	square_mark_redraw(c, loc(c->width - 1, c->height - 1));
+	eq(count_marked(c), 1);
+	cave_clear_redraw(c);
+	eq(count_marked(c), 0);
+	ok;
+}
+
+static int test_hidden(void *state) {
+	bool (*old_hook)(void) = map_is_visible_hook;
+	bool old_generated = character_generated;
+
+	map_is_visible_hook = map_hidden;
+	character_generated = true;
+	event_add_handler(EVENT_MAP, draw_marked, NULL);
+	player->upkeep->redraw = 0;
+	cave_clear_redraw(cave);
+	map_signals = 0;
+
+	/* Grids changed while the map is covered still go to the subwindows */
+	square_light_spot(cave, player->grid);
+	require(cave_redraw_pending(cave));
+	redraw_stuff(player);
+	eq(map_signals, 1);
+	require(!cave_redraw_pending(cave));
+
+	/* With nothing changed, there's nothing to draw */
+	player->upkeep->redraw |= PR_ITEMLIST;
+	redraw_stuff(player);
+	eq(map_signals, 1);
+
+	event_remove_handler(EVENT_MAP, draw_marked, NULL);
+	character_generated = old_generated;
+	map_is_visible_hook = old_hook;
+	ok;
+}
+
+const char *suite_name = "cave/redraw";
+struct test tests[] = {
+	{ "mark", test_mark },
+	{ "clear", test_clear },
+	{ "hidden", test_hidden },
+	{ NULL, NULL }
+};
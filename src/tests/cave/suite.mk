@@ -1,3 +1,5 @@
 TESTPROGS += \
 	cave/find \
+	cave/noise \
+	cave/redraw \
 	cave/scatter
@@ -80,6 +80,7 @@ int setup_tests(void **state) {
 
 int teardown_tests(void *state) {
 	file_delete("Test1");
+	file_delete("Test2");
 	wipe_mon_list(cave, player);
 	cleanup_angband();
 	return 0;
@@ -106,6 +107,49 @@ static int test_newgame(void *state) {
 	ok;
 }
 
+/* Check that two files have the same contents */
+static bool same_file(const char *path1, const char *path2) {
+	ang_file *f1 = file_open(path1, MODE_READ, FTYPE_TEXT);
+	ang_file *f2 = file_open(path2, MODE_READ, FTYPE_TEXT);
+	char buf1[1024], buf2[1024];
+	bool same = f1 && f2;
+
+	while (same) {
+		int len1 = file_read(f1, buf1, sizeof(buf1));
+		int len2 = file_read(f2, buf2, sizeof(buf2));
+
+		if (len1 != len2 || memcmp(buf1, buf2, MAX(len1, 0)))
+			same = false;
+		if (len1 <= 0) break;
+	}
+	if (f1) file_close(f1);
+	if (f2) file_close(f2);
+	return same;
+}
+
+static int test_background_save(void *state) {
+	bool written = false;
+
+	/* A save written while play carries on is the same as any other */
+	eq(savefile_save_background("Test2"), true);
+	eq(savefile_wait(), true);
+	eq(file_exists("Test2"), true);
+	require(same_file("Test1", "Test2"));
+
+	/* Nothing left to wait for */
+	eq(savefile_wait(), true);
+
+	/* Checking on one without waiting finds it once it is written */
+	eq(savefile_save_background("Test2"), true);
+	while (!savefile_poll(&written))
+		;
+	eq(written, true);
+	eq(savefile_poll(&written), false);
+	require(same_file("Test1", "Test2"));
+
+	ok;
+}
+
 static int test_loadgame(void *state) {
 	reset_before_load();
 
@@ -253,6 +297,7 @@ static int test_drop_eat(void *state) {
 const char *suite_name = "game/basic";
 struct test tests[] = {
 	{ "newgame", test_newgame },
+	{ "background_save", test_background_save },
 	{ "loadgame", test_loadgame },
 	{ "stairs1", test_stairs1 },
 	{ "stairs2", test_stairs2 },
@@ -0,0 +1,152 @@
+/* game/persist
+ *
+ * Check that stored levels are packed away when left, moved out to the spill
+ * file when over budget, and come back as they were, both in play and
+ * through a savefile.
+ */
+
+#include "unit-test.h"
+#include "test-utils.h"
+
+#include "cave.h"
+#include "game-world.h"
+#include "generate.h"
+#include "init.h"
+#include "mon-make.h"
+#include "player.h"
+#include "player-birth.h"
+#include "player-util.h"
+#include "savefile.h"
+#include "z-util.h"
+
+#define TEST_FILE "Test-persist"
+
+/* Terrain of the first dungeon level, as it was when it was left */
+static uint16_t *level_feats;
+static int level_height, level_width;
+
+static void println(const char *str) {
+	printf("%s\n", str);
+}
+
+int setup_tests(void **state) {
+	plog_aux = println;
+	set_file_paths();
+	init_angband();
+#ifdef UNIX
+	/* Necessary for creating the randart file. */
+	create_needed_dirs();
+#endif
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	file_delete(TEST_FILE);
+	mem_free(level_feats);
+	wipe_mon_list(cave, player);
+	cleanup_angband();
+	return 0;
+}
+
+static void go_to_depth(int depth) {
+	dungeon_change_level(player, depth);
+	prepare_next_level(player);
+	on_new_level();
+}
+
+static void note_feats(struct chunk *c) {
+	int y, x;
+
+	mem_free(level_feats);
+	level_height = c->height;
+	level_width = c->width;
+	level_feats = mem_alloc(level_height * level_width * sizeof(uint16_t));
+	for (y = 0; y < c->height; y++) {
+		for (x = 0; x < c->width; x++) {
+			level_feats[y * c->width + x] = square(c, loc(x, y))->feat;
+		}
+	}
+}
+
+static bool same_feats(struct chunk *c) {
+	int y, x;
+
+	if (c->height != level_height || c->width != level_width) return false;
+	for (y = 0; y < c->height; y++) {
+		for (x = 0; x < c->width; x++) {
+			if (level_feats[y * c->width + x] != square(c, loc(x, y))->feat)
+				return false;
+		}
+	}
+	return true;
+}
+
+static int test_pack(void *state) {
+	const char *name = level_by_depth(1)->name;
+	struct chunk *c;
+
+	eq(player_make_simple(NULL, NULL, "Tester"), true);
+	player->opts.opt[OPT_birth_levels_persist] = true;
+	prepare_next_level(player);
+	on_new_level();
+
+	/* Nothing may stay in memory once packed */
+	z_info->level_store_kb = 0;
+
+	go_to_depth(1);
+	note_feats(cave);
+	go_to_depth(2);
+
+	/* The level left is packed, with what finds it still to hand */
+	c = chunk_peek_name(name);
+	notnull(c);
+	notnull(c->pack);
+	eq(c->depth, 1);
+	eq(c->height, level_height);
+	eq(c->width, level_width);
+	notnull(chunk_peek_name(format("%s known", name)));
+	notnull(chunk_peek_name("Town"));
+	notnull(chunk_peek_name("Town")->pack);
+
+	/* Packed levels go straight into the savefile */
+	eq(savefile_save(TEST_FILE), true);
+
+	/* Coming back unpacks it as it was */
+	go_to_depth(1);
+	eq(cave, c);
+	null(cave->pack);
+	require(same_feats(cave));
+	notnull(chunk_peek_name(level_by_depth(2)->name)->pack);
+
+	ok;
+}
+
+static int test_load(void *state) {
+	struct chunk *c;
+
+	play_again = true;
+	wipe_mon_list(cave, player);
+	cleanup_angband();
+	init_angband();
+	play_again = false;
+
+	eq(savefile_load(TEST_FILE, false), true);
+	require(character_dungeon);
+	on_new_level();
+	eq(player->depth, 2);
+
+	/* The level written packed reads back the same */
+	c = chunk_find_name(level_by_depth(1)->name);
+	notnull(c);
+	null(c->pack);
+	require(same_feats(c));
+
+	ok;
+}
+
+const char *suite_name = "game/persist";
+struct test tests[] = {
+	{ "pack", test_pack },
+	{ "load", test_load },
+	{ NULL, NULL }
+};
@@ -298,6 +298,50 @@ static int test_many_repeat(void *state)
 	ok;
 }
 
+/* Fill in buf with text of a length and letter depending on i */
+static void make_long_message(char *buf, int i) {
+	int len = (i * 7919) % 3000, j;
+
+	strnfmt(buf, 16, "%d:", i);
+	for (j = strlen(buf); j < len; j++)
+		buf[j] = 'a' + i % 26;
+	buf[j] = '\0';
+}
+
+static int test_long_text(void *state)
+{
+	char buf[3100], buf2[3100];
+	uint16_t n, j;
+	int i;
+
+	messages_free();
+	messages_init();
+
+	/* Enough text to wrap round and grow the text buffer many times */
+	for (i = 0; i < 10000; i++) {
+		make_long_message(buf, i);
+		message_add(buf, MSG_GENERIC);
+		require(streq(message_str(0), buf));
+		n = messages_num();
+		make_long_message(buf2, i + 1 - n);
+		require(streq(message_str(n - 1), buf2));
+	}
+	n = messages_num();
+	for (j = 0; j < n; j++) {
+		make_long_message(buf, i - 1 - j);
+		require(streq(message_str(j), buf));
+		eq(message_count(j), 1);
+	}
+
+	/* Adding the text of an old message copies it */
+	make_long_message(buf, i - 1 - (n - 1));
+	message_add(message_str(n - 1), MSG_GENERIC);
+	require(streq(message_str(0), buf));
+	eq(messages_num(), n);
+
+	ok;
+}
+
 static int test_color(void *state) {
 	uint8_t color;
 
@@ -663,6 +707,7 @@ struct test tests[] = {
 	{ "add", test_add },
 	{ "fill", test_fill },
 	{ "many_repeat", test_many_repeat },
+	{ "long_text", test_long_text },
 	{ "color", test_color },
 	{ "format", test_msg },
 	{ "sound", test_sound },
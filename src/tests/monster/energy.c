@@ -0,0 +1,189 @@
+/* monster/energy
+ *
+ * Check that scheduling monsters by when they next act gives them the same
+ * energy and turns as energizing every monster on every game turn.
+ */
+
+#include "game-world.h"
+#include "init.h"
+#include "mon-make.h"
+#include "mon-move.h"
+#include "mon-timed.h"
+#include "player-birth.h"
+#include "test-utils.h"
+#include "unit-test.h"
+
+#define NUM_MON 4
+
+/* Model of one monster, energized every game turn */
+struct model {
+	struct monster *mon;
+	int energy;
+	int fast;
+	int slow;
+	int hold;
+};
+
+int setup_tests(void **state) {
+	set_file_paths();
+	if (!init_angband()) {
+		return 1;
+	}
+	player_make_simple(NULL, NULL, "Tester");
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	cleanup_angband();
+	return 0;
+}
+
+/*
+ * Place monsters which are hurt, so they stay active, but held, so they do
+ * nothing on their turns except count down their timed effects
+ */
+static void place_monsters(struct chunk *c, struct model *m) {
+	const char *races[NUM_MON] = { "wolf", "cave spider", "floating eye",
+		"large white snake" };
+	int i;
+
+	for (i = 0; i < NUM_MON; i++) {
+		struct monster *mon = t_add_monster(c, loc(3 + 3 * i, 4),
+			races[i]);
+		mon->hp = 1;
+		mon->m_timed[MON_TMD_HOLD] = 50;
+		m[i].mon = mon;
+		m[i].energy = mon->energy;
+		m[i].fast = 0;
+		m[i].slow = 0;
+		m[i].hold = 50;
+	}
+}
+
+static void model_turn(struct model *m) {
+	int i;
+
+	for (i = 0; i < NUM_MON; i++) {
+		bool moving = m[i].energy >= z_info->move_energy;
+		int mspeed = m[i].mon->mspeed;
+
+		if (m[i].fast) mspeed += 10;
+		if (m[i].slow) mspeed -= 2 * MIN((m[i].slow + 9) / 10, 5);
+		m[i].energy += turn_energy(mspeed);
+		if (!moving) continue;
+
+		m[i].energy -= z_info->move_energy;
+		if (m[i].fast) m[i].fast--;
+		if (m[i].slow) m[i].slow--;
+		m[i].hold--;
+	}
+}
+
+static void game_turn(struct model *m) {
+	process_monsters(0);
+	reset_monsters();
+	model_turn(m);
+	turn++;
+}
+
+static bool monsters_match_model(struct chunk *c, struct model *m) {
+	int i;
+
+	monsters_sync_energy(c);
+	for (i = 0; i < NUM_MON; i++) {
+		if (m[i].mon->energy != m[i].energy) return false;
+		if (m[i].mon->m_timed[MON_TMD_FAST] != m[i].fast) return false;
+		if (m[i].mon->m_timed[MON_TMD_SLOW] != m[i].slow) return false;
+		if (m[i].mon->m_timed[MON_TMD_HOLD] != m[i].hold) return false;
+	}
+	return true;
+}
+
+static int test_energy(void *state) {
+	struct chunk *c = t_build_arena(10, 20);
+	struct model m[NUM_MON];
+	int t;
+
+	cave = c;
+	turn = 1;
+	place_monsters(c, m);
+
+	for (t = 0; t < 50; t++)
+		game_turn(m);
+	require(monsters_match_model(c, m));
+
+	/* Speed changes between turns */
+	require(mon_inc_timed(m[0].mon, MON_TMD_FAST, 10, MON_TMD_FLG_NOFAIL));
+	m[0].fast = 10;
+	require(mon_inc_timed(m[1].mon, MON_TMD_SLOW, 15, MON_TMD_FLG_NOFAIL));
+	m[1].slow = 15;
+	for (t = 0; t < 30; t++)
+		game_turn(m);
+
+	/* Energy is written back part way through, as for a save */
+	require(monsters_match_model(c, m));
+
+	/* Run past a regeneration turn and until the effects wear off */
+	for (t = 0; t < 70; t++)
+		game_turn(m);
+	require(monsters_match_model(c, m));
+	eq(m[0].fast, 0);
+	eq(m[1].slow, 0);
+
+	cave = NULL;
+	cave_free(c);
+	ok;
+}
+
+static int test_renumber(void *state) {
+	struct chunk *c = t_build_arena(10, 20);
+	struct model m[NUM_MON];
+	int i, t;
+
+	cave = c;
+	turn = 1;
+	place_monsters(c, m);
+	for (t = 0; t < 20; t++)
+		game_turn(m);
+
+	/* Close the hole left by the first monster */
+	delete_monster_idx(c, m[0].mon->midx);
+	compact_monsters(c, 0);
+	for (i = 0; i < NUM_MON - 1; i++) {
+		m[i] = m[i + 1];
+		m[i].mon = square_monster(c, loc(6 + 3 * i, 4));
+		require(m[i].mon);
+	}
+
+	/* Model only the monsters that are left */
+	for (t = 0; t < 40; t++) {
+		process_monsters(0);
+		reset_monsters();
+		for (i = 0; i < NUM_MON - 1; i++) {
+			bool moving = m[i].energy >= z_info->move_energy;
+			m[i].energy += turn_energy(m[i].mon->mspeed);
+			if (moving) {
+				m[i].energy -= z_info->move_energy;
+				m[i].hold--;
+			}
+		}
+		turn++;
+	}
+
+	monsters_sync_energy(c);
+	for (i = 0; i < NUM_MON - 1; i++) {
+		eq(m[i].mon->energy, m[i].energy);
+		eq(m[i].mon->m_timed[MON_TMD_HOLD], m[i].hold);
+	}
+
+	cave = NULL;
+	cave_free(c);
+	ok;
+}
+
+const char *suite_name = "monster/energy";
+struct test tests[] = {
+	{ "energy", test_energy },
+	{ "renumber", test_renumber },
+	{ NULL, NULL }
+};
@@ -128,9 +128,79 @@ static int test_nearby_kin(void *state) {
 	ok;
 }
 
+static bool only_grip(struct monster_race *race)
+{
+	return streq(race->name, "Grip, Farmer Maggot's Dog");
+}
+
+static int test_get_mon_num_unique(void *state) {
+	struct chunk *c = t_build_arena(20, 20);
+	struct monster_race *grip = lookup_monster("Grip, Farmer Maggot's Dog");
+	struct monster *mon;
+
+	get_mon_num_prep(only_grip);
+	ptreq(get_mon_num(10, 10), grip);
+
+	/* Only one Grip can be around at a time */
+	mon = t_add_monster(c, loc(5, 5), grip->name);
+	ptreq(get_mon_num(10, 10), NULL);
+
+	/* Allowed again once gone */
+	delete_monster_idx(c, mon->midx);
+	ptreq(get_mon_num(10, 10), grip);
+
+	/* Not at all once dead */
+	grip->max_num = 0;
+	invalidate_mon_num_tables();
+	ptreq(get_mon_num(10, 10), NULL);
+	grip->max_num = 1;
+	invalidate_mon_num_tables();
+
+	get_mon_num_prep(NULL);
+	wipe_mon_list(c, player);
+	cave_free(c);
+	ok;
+}
+
+static struct monster_base *test_base;
+
+static bool base_okay(struct monster_race *race)
+{
+	return race->base == test_base;
+}
+
+static int test_get_mon_num_cached(void *state) {
+	struct monster_base *canine = lookup_monster_base("canine");
+	struct monster_base *feline = lookup_monster_base("feline");
+	struct monster_race *race;
+	int i;
+
+	/* The restriction is remembered for each base */
+	test_base = canine;
+	get_mon_num_prep_cached(base_okay, canine);
+	test_base = feline;
+	get_mon_num_prep_cached(base_okay, feline);
+	for (i = 0; i < 20; i++) {
+		race = get_mon_num(20, 20);
+		require(race);
+		ptreq(race->base, feline);
+	}
+	get_mon_num_prep_cached(base_okay, canine);
+	for (i = 0; i < 20; i++) {
+		race = get_mon_num(20, 20);
+		require(race);
+		ptreq(race->base, canine);
+	}
+
+	get_mon_num_prep(NULL);
+	ok;
+}
+
 const char *suite_name = "monster/monster";
 struct test tests[] = {
 	{ "match_monster_bases", test_match_monster_bases },
 	{ "nearby_kin", test_nearby_kin },
+	{ "get_mon_num_unique", test_get_mon_num_unique },
+	{ "get_mon_num_cached", test_get_mon_num_cached },
 	{ NULL, NULL }
 };
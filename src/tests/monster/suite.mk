@@ -1 +1 @@
-TESTPROGS += monster/attack monster/desc monster/monster
+TESTPROGS += monster/attack monster/desc monster/energy monster/monster
@@ -0,0 +1,142 @@
+/* object/lookup.c */
+/* Check the indexed lookups by name and number against plain searches. */
+
+#include "unit-test.h"
+#include "test-utils.h"
+#include "cave.h"
+#include "init.h"
+#include "mon-util.h"
+#include "obj-desc.h"
+#include "obj-util.h"
+
+int setup_tests(void **state) {
+	set_file_paths();
+	if (!init_angband()) return 1;
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	cleanup_angband();
+	return 0;
+}
+
+static int test_kind(void *state) {
+	int k;
+
+	for (k = 0; k < z_info->k_max; k++) {
+		struct object_kind *kind = &k_info[k], *first = NULL;
+		char name[1024];
+		int j, sval = -1;
+
+		if (!kind->tval) continue;
+		for (j = 0; j < z_info->k_max && !first; j++) {
+			if (k_info[j].tval == kind->tval
+					&& k_info[j].sval == kind->sval)
+				first = &k_info[j];
+		}
+		ptreq(lookup_kind(kind->tval, kind->sval), first);
+
+		if (!kind->name) continue;
+		obj_desc_name_format(name, sizeof name, 0, kind->name, 0, false);
+		for (j = 0; j < z_info->k_max && sval < 0; j++) {
+			char cmp[1024];
+
+			if (!k_info[j].name || k_info[j].tval != kind->tval)
+				continue;
+			obj_desc_name_format(cmp, sizeof cmp, 0, k_info[j].name, 0,
+				false);
+			if (!my_stricmp(cmp, name)) sval = k_info[j].sval;
+		}
+		eq(lookup_sval(kind->tval, name), sval);
+		for (j = 0; name[j]; j++)
+			name[j] = toupper((unsigned char)name[j]);
+		eq(lookup_sval(kind->tval, name), sval);
+	}
+	eq(lookup_sval(TV_FOOD, "Not a real food"), -1);
+	eq(lookup_sval(TV_FOOD, "12"), 12);
+	ok;
+}
+
+static int test_artifact(void *state) {
+	int i;
+
+	for (i = 0; i < z_info->a_max; i++) {
+		const struct artifact *art = &a_info[i];
+		int j;
+
+		if (!art->name) continue;
+		for (j = 0; j < i; j++) {
+			if (a_info[j].name && streq(a_info[j].name, art->name))
+				break;
+		}
+		ptreq(lookup_artifact_name(art->name), &a_info[j]);
+	}
+	null(lookup_artifact_name("of No Such Artifact"));
+	ok;
+}
+
+static int test_ego(void *state) {
+	int i;
+
+	for (i = 0; i < z_info->e_max; i++) {
+		struct ego_item *ego = &e_info[i];
+		struct poss_item *poss;
+
+		if (!ego->name) continue;
+		for (poss = ego->poss_items; poss; poss = poss->next) {
+			struct object_kind *kind = &k_info[poss->kidx];
+			struct ego_item *found =
+				lookup_ego_item(ego->name, kind->tval, kind->sval);
+
+			notnull(found);
+			require(streq(found->name, ego->name));
+			require(found <= ego);
+		}
+	}
+	ok;
+}
+
+static int test_monster(void *state) {
+	struct monster_base *base;
+	int i;
+
+	for (i = 0; i < z_info->r_max; i++) {
+		struct monster_race *race = &r_info[i];
+		int j;
+
+		if (!race->name) continue;
+		for (j = 0; j < i; j++) {
+			if (r_info[j].name && !my_stricmp(r_info[j].name, race->name))
+				break;
+		}
+		ptreq(lookup_monster(race->name), &r_info[j]);
+	}
+	for (base = rb_info; base; base = base->next)
+		ptreq(lookup_monster_base(base->name), base);
+	null(lookup_monster_base("no such base"));
+
+	/* Names which are not exact still find a race by substring */
+	notnull(lookup_monster("grip, farmer"));
+	null(lookup_monster("no such monster"));
+	ok;
+}
+
+static int test_feat(void *state) {
+	int i;
+
+	for (i = 0; i < FEAT_MAX; i++) {
+		if (!f_info[i].name) continue;
+		eq(lookup_feat(f_info[i].name), i);
+	}
+	ok;
+}
+
+const char *suite_name = "object/lookup";
+struct test tests[] = {
+	{ "kind", test_kind },
+	{ "artifact", test_artifact },
+	{ "ego", test_ego },
+	{ "monster", test_monster },
+	{ "feat", test_feat },
+	{ NULL, NULL }
+};
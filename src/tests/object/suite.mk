@@ -2,6 +2,7 @@ TESTPROGS += \
 	object/alloc \
 	object/attack \
 	object/info \
+	object/lookup \
 	object/pile \
 	object/slays \
 	object/util
@@ -0,0 +1,80 @@
+/* parse/flags
+ *
+ * Check lookup_flag() and code_index_in_array() against searching the lists
+ * of names in order.
+ */
+
+#include "unit-test.h"
+#include "datafile.h"
+#include "init.h"
+#include "mon-init.h"
+
+NOSETUP
+
+int teardown_tests(void *state) {
+	cleanup_name_tables();
+	return 0;
+}
+
+static const char *dup_names[] = {
+	"NONE", "A", "B", "NONE", "A", "C", NULL
+};
+
+static int linear_index(const char **names, int start, const char *name) {
+	int i;
+
+	for (i = start; names[i]; i++) {
+		if (streq(names[i], name)) return i;
+	}
+	return -1;
+}
+
+static bool list_matches(const char **names) {
+	int i;
+
+	for (i = 0; names[i]; i++) {
+		int flag = linear_index(names, FLAG_START, names[i]);
+
+		if (code_index_in_array(names, names[i])
+				!= linear_index(names, 0, names[i]))
+			return false;
+		if (lookup_flag(names, names[i]) != (flag < 0 ? FLAG_END : flag))
+			return false;
+	}
+	return code_index_in_array(names, "NO_SUCH_NAME") == -1
+		&& lookup_flag(names, "NO_SUCH_NAME") == FLAG_END
+		&& lookup_flag(names, "") == FLAG_END;
+}
+
+static int test_lists(void *state) {
+	require(list_matches(r_info_flags));
+	require(list_matches(r_info_spell_flags));
+	require(list_matches(list_obj_flag_names));
+	require(list_matches(list_element_names));
+	ok;
+}
+
+static int test_duplicates(void *state) {
+	eq(code_index_in_array(dup_names, "NONE"), 0);
+	eq(lookup_flag(dup_names, "NONE"), 3);
+	eq(code_index_in_array(dup_names, "A"), 1);
+	eq(lookup_flag(dup_names, "A"), 1);
+	eq(lookup_flag(dup_names, "C"), 5);
+	eq(lookup_flag(dup_names, "a"), FLAG_END);
+	ok;
+}
+
+static int test_rebuild(void *state) {
+	cleanup_name_tables();
+	eq(lookup_flag(dup_names, "B"), 2);
+	require(list_matches(r_info_flags));
+	ok;
+}
+
+const char *suite_name = "parse/flags";
+struct test tests[] = {
+	{ "lists", test_lists },
+	{ "duplicates", test_duplicates },
+	{ "rebuild", test_rebuild },
+	{ NULL, NULL }
+};
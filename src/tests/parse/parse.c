@@ -3,6 +3,8 @@
 #include "unit-test.h"
 
 #include "parser.h"
+#include "z-form.h"
+#include "z-virt.h"
 #ifndef WINDOWS
 #include <locale.h>
 #include <langinfo.h>
@@ -561,6 +563,115 @@ static int test_char2(void *state) {
 	ok;
 }
 
+/* Collects what the hooks see, to compare parsing with replaying */
+struct replay_seen {
+	char text[256];
+	int lines;
+};
+
+static enum parser_error helper_replay_a(struct parser *p) {
+	struct replay_seen *seen = parser_priv(p);
+	struct random r = parser_getrand(p, "r");
+	struct parser_state s;
+
+	parser_getstate(p, &s);
+	my_strcat(seen->text, format("a%u:%d:%s:%d/%d/%d/%d:%s;", s.line,
+		parser_getint(p, "i"), parser_getsym(p, "s"), r.base, r.dice,
+		r.sides, r.m_bonus, parser_hasval(p, "t") ?
+		parser_getstr(p, "t") : "-"), sizeof(seen->text));
+	seen->lines++;
+	return PARSE_ERROR_NONE;
+}
+
+static enum parser_error helper_replay_b(struct parser *p) {
+	struct replay_seen *seen = parser_priv(p);
+
+	my_strcat(seen->text, format("b%u:%c;", parser_getuint(p, "u"),
+		(char)parser_getchar(p, "c")), sizeof(seen->text));
+	seen->lines++;
+	return (parser_getuint(p, "u") == 99) ? PARSE_ERROR_INVALID_VALUE
+		: PARSE_ERROR_NONE;
+}
+
+static struct parser *replay_parser(struct replay_seen *seen) {
+	struct parser *p = parser_new();
+
+	parser_reg(p, "a int i sym s rand r ?str t", helper_replay_a);
+	parser_reg(p, "b uint u char c", helper_replay_b);
+	memset(seen, 0, sizeof(*seen));
+	parser_setpriv(p, seen);
+	return p;
+}
+
+static int test_replay0(void *state) {
+	const char *lines[] = { "# comment", "a:-3:foo:2d6M1:rest: of line",
+		"", "b:7:x", "a:12:bar:-4" };
+	struct replay_seen seen0, seen1;
+	struct parser *p0 = replay_parser(&seen0);
+	struct parser *p1 = replay_parser(&seen1);
+	const uint8_t *rec;
+	uint8_t *copy;
+	size_t len, i;
+
+	eq(parser_signature(p0), parser_signature(p1));
+	parser_record(p0, true);
+	for (i = 0; i < N_ELEMENTS(lines); i++)
+		eq(parser_parse(p0, lines[i]), PARSE_ERROR_NONE);
+	parser_record(p0, false);
+	eq(seen0.lines, 3);
+	require(streq(seen0.text, "a2:-3:foo:0/2/6/1:rest: of line;b7:x;"
+		"a5:12:bar:-4/0/0/0:-;"));
+
+	/* Replaying gives the hooks the same values on the same lines */
+	rec = parser_recording(p0, &len);
+	copy = mem_alloc(len);
+	memcpy(copy, rec, len);
+	require(parser_replay_check(p1, copy, len));
+	eq(seen1.lines, 0);
+	eq(parser_replay(p1, copy, len), PARSE_ERROR_NONE);
+	eq(seen1.lines, 3);
+	require(streq(seen0.text, seen1.text));
+
+	mem_free(copy);
+	parser_destroy(p1);
+	parser_destroy(p0);
+	ok;
+}
+
+static int test_replay1(void *state) {
+	struct replay_seen seen0, seen1;
+	struct parser *p0 = replay_parser(&seen0);
+	struct parser *p1 = replay_parser(&seen1);
+	struct parser_state s;
+	const uint8_t *rec;
+	size_t len;
+
+	parser_record(p0, true);
+	eq(parser_parse(p0, "b:1:y"), PARSE_ERROR_NONE);
+	eq(parser_parse(p0, "b:99:z"), PARSE_ERROR_INVALID_VALUE);
+	rec = parser_recording(p0, &len);
+
+	/* A cut short recording is refused before any hook is run */
+	require(!parser_replay_check(p1, rec, len - 1));
+	require(!parser_replay_check(p1, rec, 7));
+	eq(seen1.lines, 0);
+
+	/* Errors from hooks come back as they did when parsing */
+	require(parser_replay_check(p1, rec, len));
+	eq(parser_replay(p1, rec, len), PARSE_ERROR_INVALID_VALUE);
+	require(parser_getstate(p1, &s));
+	eq(s.line, 2);
+	require(streq(seen0.text, seen1.text));
+
+	/* Different hooks have a different signature */
+	parser_reg(p1, "c int i", ignored);
+	require(parser_signature(p0) != parser_signature(p1));
+
+	parser_destroy(p1);
+	parser_destroy(p0);
+	ok;
+}
+
 const char *suite_name = "parse/parser";
 struct test tests[] = {
 	{ "priv", test_priv },
@@ -606,5 +717,8 @@ struct test tests[] = {
 
 	{ "baddir", test_baddir },
 
+	{ "replay0", test_replay0 },
+	{ "replay1", test_replay1 },
+
 	{ NULL, NULL }
 };
@@ -7,6 +7,7 @@ TESTPROGS += parse/a-info \
 	parse/c-info \
 	parse/e-info \
 	parse/f-info \
+	parse/flags \
 	parse/flavor \
 	parse/graphics \
 	parse/h-info \
@@ -32,6 +33,7 @@ TESTPROGS += parse/a-info \
 	parse/realm \
 	parse/shape \
 	parse/slay \
+	parse/throughput \
 	parse/ui_knowledge \
 	parse/v-info \
 	parse/world \
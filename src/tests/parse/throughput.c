@@ -0,0 +1,262 @@
+/* parse/throughput
+ *
+ * Check that reading all of lib/gamedata from the cache of parsed values gives
+ * the same records as reading the text files, and time both.  The cache is
+ * kept in a directory of its own rather than the user's.  Run with -v to see
+ * the timings.
+ */
+
+#include "unit-test.h"
+#include "test-utils.h"
+#include "cave.h"
+#include "init.h"
+#include "monster.h"
+#include "object.h"
+#include "z-file.h"
+#include "z-form.h"
+#include <time.h>
+
+#define ITERATIONS 3
+#define TEST_DIR "parse-throughput.tmp"
+
+/* Size of the text read in one pass over the data files */
+struct gamedata_size {
+	long bytes;
+	long lines;
+};
+
+/* Counts of records and a hash of some fields of each, from one pass */
+struct gamedata_snapshot {
+	int counts[10];
+	uint32_t hash;
+	char first_race[80];
+	char last_kind[80];
+};
+
+/* What reading the text files gave, to hold the cached passes to */
+static struct gamedata_snapshot from_text;
+static char *user_dir;
+
+int setup_tests(void **state) {
+	struct gamedata_size *size = mem_zalloc(sizeof(*size));
+	char name[256], path[1024];
+	ang_dir *dir;
+
+	set_file_paths();
+	dir = my_dopen(ANGBAND_DIR_GAMEDATA);
+	if (!dir) {
+		mem_free(size);
+		return 1;
+	}
+	while (my_dread(dir, name, sizeof(name))) {
+		ang_file *f;
+		uint8_t c;
+
+		if (!suffix(name, ".txt")) continue;
+		path_build(path, sizeof(path), ANGBAND_DIR_GAMEDATA, name);
+		f = file_open(path, MODE_READ, FTYPE_TEXT);
+		if (!f) continue;
+		while (file_readc(f, &c)) {
+			size->bytes++;
+			if (c == '\n') size->lines++;
+		}
+		file_close(f);
+	}
+	my_dclose(dir);
+
+	/* The cache goes under a user directory of the test's own */
+	if (!dir_create(TEST_DIR)) {
+		mem_free(size);
+		return 1;
+	}
+	user_dir = ANGBAND_DIR_USER;
+	ANGBAND_DIR_USER = string_make(TEST_DIR);
+
+	/* Keep the paths between passes */
+	play_again = true;
+	*state = size;
+	return 0;
+}
+
+/* Remove the cache files, returning how many there were */
+static int clear_cache(void) {
+	char dirpath[1024], name[256], path[1024];
+	ang_dir *dir;
+	int n = 0;
+
+	path_build(dirpath, sizeof(dirpath), ANGBAND_DIR_USER, "cache");
+	dir = my_dopen(dirpath);
+	if (!dir) return 0;
+	while (my_dread(dir, name, sizeof(name))) {
+		path_build(path, sizeof(path), dirpath, name);
+		if (file_delete(path)) n++;
+	}
+	my_dclose(dir);
+	return n;
+}
+
+int teardown_tests(void *state) {
+	char path[1024];
+
+	clear_cache();
+	path_build(path, sizeof(path), ANGBAND_DIR_USER, "cache");
+	file_delete(path);
+	file_delete(TEST_DIR);
+	string_free(ANGBAND_DIR_USER);
+	ANGBAND_DIR_USER = user_dir;
+	mem_free(state);
+	play_again = false;
+	return 0;
+}
+
+static uint32_t hash_int(uint32_t h, int v) {
+	return (h ^ (uint32_t)v) * 16777619u;
+}
+
+static uint32_t hash_str(uint32_t h, const char *s) {
+	if (!s) return hash_int(h, -1);
+	while (*s) h = hash_int(h, (unsigned char)*s++);
+	return hash_int(h, 0);
+}
+
+static void take_snapshot(struct gamedata_snapshot *snap) {
+	uint32_t h = 2166136261u;
+	int i;
+
+	memset(snap, 0, sizeof(*snap));
+	snap->counts[0] = z_info->k_max;
+	snap->counts[1] = z_info->a_max;
+	snap->counts[2] = z_info->e_max;
+	snap->counts[3] = z_info->r_max;
+	snap->counts[4] = z_info->trap_max;
+	snap->counts[5] = z_info->store_max;
+	snap->counts[6] = z_info->s_max;
+	snap->counts[7] = z_info->pit_max;
+	snap->counts[8] = z_info->curse_max;
+	snap->counts[9] = z_info->profile_max;
+
+	for (i = 0; i < z_info->k_max; i++) {
+		const struct object_kind *kind = &k_info[i];
+
+		h = hash_str(h, kind->name);
+		h = hash_int(h, kind->tval);
+		h = hash_int(h, kind->sval);
+		h = hash_int(h, kind->weight);
+		h = hash_int(h, kind->cost);
+		if (kind->name) {
+			my_strcpy(snap->last_kind, kind->name,
+				sizeof(snap->last_kind));
+		}
+	}
+	for (i = 0; i < z_info->a_max; i++) {
+		h = hash_str(h, a_info[i].name);
+		h = hash_int(h, a_info[i].tval);
+		h = hash_int(h, a_info[i].sval);
+		h = hash_int(h, a_info[i].weight);
+		h = hash_int(h, a_info[i].cost);
+	}
+	for (i = 0; i < z_info->e_max; i++) {
+		h = hash_str(h, e_info[i].name);
+		h = hash_int(h, e_info[i].cost);
+		h = hash_int(h, e_info[i].alloc_prob);
+	}
+	for (i = 0; i < z_info->r_max; i++) {
+		const struct monster_race *race = &r_info[i];
+
+		h = hash_str(h, race->name);
+		h = hash_int(h, race->speed);
+		h = hash_int(h, race->avg_hp);
+		h = hash_int(h, race->ac);
+		h = hash_int(h, race->level);
+		h = hash_int(h, race->mexp);
+		if (race->name && !snap->first_race[0]) {
+			my_strcpy(snap->first_race, race->name,
+				sizeof(snap->first_race));
+		}
+	}
+	for (i = 0; i < FEAT_MAX; i++) {
+		h = hash_str(h, f_info[i].name);
+		h = hash_int(h, f_info[i].priority);
+	}
+	snap->hash = h;
+}
+
+static bool same_snapshot(const struct gamedata_snapshot *a,
+		const struct gamedata_snapshot *b) {
+	return !memcmp(a->counts, b->counts, sizeof(a->counts))
+		&& a->hash == b->hash
+		&& streq(a->first_race, b->first_race)
+		&& streq(a->last_kind, b->last_kind);
+}
+
+/*
+ * Time init_angband(), clearing the cache first if text is set.  Each pass
+ * must give the same records as the text files did.
+ */
+static bool time_passes(struct gamedata_size *size, bool text) {
+	double best = 0.0;
+	int i;
+
+	for (i = 0; i < ITERATIONS; i++) {
+		struct gamedata_snapshot snap;
+		clock_t start;
+		double secs;
+
+		if (text) clear_cache();
+		start = clock();
+		if (!init_angband()) return false;
+		secs = (double)(clock() - start) / CLOCKS_PER_SEC;
+		take_snapshot(&snap);
+		cleanup_angband();
+		if (text && i == 0) {
+			from_text = snap;
+		} else if (!same_snapshot(&snap, &from_text)) {
+			if (verbose) {
+				printf("pass %d differs from the text files\n",
+					i + 1);
+			}
+			return false;
+		}
+		if (i == 0 || secs < best) best = secs;
+	}
+
+	if (verbose) {
+		printf("%.1f ms", best * 1000);
+		if (best > 0) {
+			printf(", %.0f lines/s, %.2f MB/s", size->lines / best,
+				size->bytes / best / (1024 * 1024));
+		}
+		printf("\n");
+	}
+	return true;
+}
+
+static int test_text(void *state) {
+	require(time_passes(state, true));
+
+	/* Something was read */
+	require(from_text.counts[0] > 0);
+	require(from_text.counts[3] > 0);
+	require(from_text.first_race[0]);
+	ok;
+}
+
+static int test_cached(void *state) {
+	char dirpath[1024], path[1024];
+
+	/* The text passes left a cache behind */
+	path_build(dirpath, sizeof(dirpath), ANGBAND_DIR_USER, "cache");
+	require(dir_exists(dirpath));
+	path_build(path, sizeof(path), dirpath, "object.dat");
+	require(file_exists(path));
+
+	require(time_passes(state, false));
+	ok;
+}
+
+const char *suite_name = "parse/throughput";
+struct test tests[] = {
+	{ "text", test_text },
+	{ "cached", test_cached },
+	{ NULL, NULL }
+};
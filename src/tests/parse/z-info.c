@@ -126,6 +126,7 @@ TEST_CONSTANT(feeling_total, "feeling-total", "world")
 TEST_CONSTANT(feeling_need, "feeling-need", "world")
 TEST_CONSTANT(stair_skip, "stair-skip", "world")
 TEST_CONSTANT(move_energy, "move-energy", "world")
+TEST_CONSTANT(level_store_kb, "level-store-kb", "world")
 
 TEST_CONSTANT(pack_size, "pack-size", "carry-cap")
 TEST_CONSTANT(quiver_size, "quiver-size", "carry-cap")
@@ -437,6 +438,7 @@ struct test tests[] = {
 	{ "feeling_need", test_feeling_need },
 	{ "stair_skip", test_stair_skip },
 	{ "move_energy", test_move_energy },
+	{ "level_store_kb", test_level_store_kb },
 	{ "pack_size", test_pack_size },
 	{ "quiver_size", test_quiver_size },
 	{ "quiver_slot_size", test_quiver_slot_size },
@@ -0,0 +1,253 @@
+/* sdl2/atlas
+ *
+ * Exercise the SDL2 front end's atlas of glyphs outside the ASCII cache:
+ * that it grows, that it gives up the glyph drawn longest ago once it can't,
+ * and that a glyph it gave up is drawn the same when it is needed again.
+ * Draws offscreen with the software renderer.
+ */
+
+#include "unit-test.h"
+#include "test-utils.h"
+#include "main-sdl2.c"
+
+/* Glyphs in the font, to compare; the ones filling the atlas are not */
+#define FIRST_GLYPH 0xE9
+#define OTHER_GLYPH 0xC5
+#define FILL_GLYPH 0x400
+
+int setup_tests(void **state) {
+	struct sdlpui_window *window = &g_app.windows[0];
+	SDL_RendererInfo info;
+	struct font *font;
+	char path[1024];
+
+	set_file_paths();
+
+	/* Draw offscreen unless told to use something else */
+	SDL_setenv("SDL_VIDEODRIVER", "dummy", 0);
+	if (SDL_Init(SDL_INIT_VIDEO) != 0) {
+		return 1;
+	}
+	if (TTF_Init() != 0) {
+		SDL_Quit();
+		return 1;
+	}
+	window->window = SDL_CreateWindow("atlas", 0, 0, 64, 64,
+		SDL_WINDOW_HIDDEN);
+	if (window->window) {
+		window->renderer = SDL_CreateRenderer(window->window, -1,
+			SDL_RENDERER_SOFTWARE | SDL_RENDERER_TARGETTEXTURE);
+	}
+	if (!window->renderer || SDL_GetRendererInfo(window->renderer, &info)
+			|| !choose_pixelformat(window, &info)) {
+		if (window->window) {
+			SDL_DestroyWindow(window->window);
+		}
+		TTF_Quit();
+		SDL_Quit();
+		return 1;
+	}
+
+	font = mem_zalloc(sizeof(*font));
+	path_build(path, sizeof(path), ANGBAND_DIR_FONTS, "8x13x.fon");
+	font->path = string_make(path);
+	font->name = string_make("8x13x.fon");
+	load_font(font);
+	make_font_cache(window, font);
+
+	*state = font;
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	struct sdlpui_window *window = &g_app.windows[0];
+
+	free_font(state);
+	SDL_DestroyRenderer(window->renderer);
+	SDL_DestroyWindow(window->window);
+	TTF_Quit();
+	SDL_Quit();
+	return 0;
+}
+
+/* Like find_glyph_atlas_slot() without counting as a use of the glyph */
+static int peek_glyph_atlas_slot(const struct font *font, uint32_t codepoint) {
+	const struct glyph_atlas *atlas = &font->cache.atlas;
+	int i;
+
+	for (i = atlas->buckets[codepoint % GLYPH_ATLAS_BUCKETS]; i;
+			i = atlas->slots[i - 1].next) {
+		if (atlas->slots[i - 1].codepoint == codepoint) {
+			return i - 1;
+		}
+	}
+	return -1;
+}
+
+/* Read what is in a slot of the atlas as ARGB8888 */
+static Uint32 *read_glyph_atlas_slot(const struct font *font, int slot) {
+	const struct sdlpui_window *window = &g_app.windows[0];
+	SDL_Rect rect = get_glyph_atlas_rect(font, slot);
+	Uint32 *pixels = mem_alloc(rect.w * rect.h * sizeof(*pixels));
+
+	SDL_SetRenderTarget(window->renderer, font->cache.atlas.texture);
+	if (SDL_RenderReadPixels(window->renderer, &rect,
+			SDL_PIXELFORMAT_ARGB8888, pixels,
+			rect.w * sizeof(*pixels)) != 0) {
+		mem_free(pixels);
+		return NULL;
+	}
+	return pixels;
+}
+
+static bool same_pixels(const struct font *font, const Uint32 *a,
+		const Uint32 *b) {
+	return !memcmp(a, b,
+		font->ttf.glyph.w * font->ttf.glyph.h * sizeof(*a));
+}
+
+/* Every slot filled is in the hash chains just once */
+static int count_chained(const struct font *font) {
+	const struct glyph_atlas *atlas = &font->cache.atlas;
+	int n = 0, b, i;
+
+	for (b = 0; b < GLYPH_ATLAS_BUCKETS; b++) {
+		for (i = atlas->buckets[b]; i; i = atlas->slots[i - 1].next) {
+			n++;
+		}
+	}
+	return n;
+}
+
+/* How many glyphs the atlas holds at most with this renderer */
+static int atlas_capacity(const struct font *font) {
+	const struct sdlpui_window *window = &g_app.windows[0];
+	int max_rows = GLYPH_ATLAS_MAX_ROWS, rows;
+	SDL_RendererInfo info;
+
+	if (SDL_GetRendererInfo(window->renderer, &info) == 0
+			&& info.max_texture_height > 0) {
+		max_rows = MIN(max_rows,
+			info.max_texture_height / font->ttf.glyph.h);
+	}
+
+	/* Rows go up by doubling from the minimum */
+	for (rows = GLYPH_ATLAS_MIN_ROWS; 2 * rows <= max_rows; rows *= 2)
+		;
+	return rows * GLYPH_ATLAS_COLS;
+}
+
+static int test_grow(void *state) {
+	const struct sdlpui_window *window = &g_app.windows[0];
+	struct font *font = state;
+	struct glyph_atlas *atlas = &font->cache.atlas;
+	int first = GLYPH_ATLAS_MIN_ROWS * GLYPH_ATLAS_COLS;
+	Uint32 *before, *after;
+	int i;
+
+	free_glyph_atlas(atlas);
+
+	/* The first glyph makes the atlas, at its smallest */
+	eq(get_glyph_atlas_slot(window, font, NULL, FIRST_GLYPH), 0);
+	notnull(atlas->texture);
+	eq(atlas->rows, GLYPH_ATLAS_MIN_ROWS);
+	before = read_glyph_atlas_slot(font, 0);
+	notnull(before);
+
+	/* It holds that many rows of glyphs before it grows */
+	for (i = 1; i < first; i++) {
+		eq(get_glyph_atlas_slot(window, font, NULL, FILL_GLYPH + i), i);
+	}
+	eq(atlas->rows, GLYPH_ATLAS_MIN_ROWS);
+	eq(get_glyph_atlas_slot(window, font, NULL, FILL_GLYPH + first),
+		first);
+	eq(atlas->rows, 2 * GLYPH_ATLAS_MIN_ROWS);
+	eq(atlas->count, first + 1);
+	eq(count_chained(font), atlas->count);
+
+	/* What was there before is kept */
+	after = read_glyph_atlas_slot(font, 0);
+	notnull(after);
+	require(same_pixels(font, before, after));
+	eq(peek_glyph_atlas_slot(font, FIRST_GLYPH), 0);
+
+	mem_free(before);
+	mem_free(after);
+	ok;
+}
+
+static int test_evict(void *state) {
+	const struct sdlpui_window *window = &g_app.windows[0];
+	struct font *font = state;
+	struct glyph_atlas *atlas = &font->cache.atlas;
+	int capacity = atlas_capacity(font);
+	Uint32 *first, *other, *again;
+	int slot, i;
+
+	free_glyph_atlas(atlas);
+
+	/* Two glyphs which look different */
+	slot = get_glyph_atlas_slot(window, font, NULL, FIRST_GLYPH);
+	require(slot >= 0);
+	first = read_glyph_atlas_slot(font, slot);
+	notnull(first);
+	slot = get_glyph_atlas_slot(window, font, NULL, OTHER_GLYPH);
+	require(slot >= 0);
+	other = read_glyph_atlas_slot(font, slot);
+	notnull(other);
+	require(!same_pixels(font, first, other));
+
+	/* Fill it */
+	for (i = 2; i < capacity; i++) {
+		require(get_glyph_atlas_slot(window, font, NULL,
+			FILL_GLYPH + i) >= 0);
+	}
+	eq(atlas->count, capacity);
+	eq(atlas->rows * GLYPH_ATLAS_COLS, capacity);
+
+	/* Draw the second glyph again so the one after is the oldest */
+	require(find_glyph_atlas_slot(font, OTHER_GLYPH) >= 0);
+
+	/* A new glyph takes the place of the one drawn longest ago */
+	slot = peek_glyph_atlas_slot(font, FIRST_GLYPH);
+	eq(get_glyph_atlas_slot(window, font, NULL, FILL_GLYPH + capacity),
+		slot);
+	eq(peek_glyph_atlas_slot(font, FIRST_GLYPH), -1);
+	slot = peek_glyph_atlas_slot(font, FILL_GLYPH + 2);
+	eq(get_glyph_atlas_slot(window, font, NULL,
+		FILL_GLYPH + capacity + 1), slot);
+	eq(peek_glyph_atlas_slot(font, FILL_GLYPH + 2), -1);
+	require(peek_glyph_atlas_slot(font, OTHER_GLYPH) >= 0);
+	eq(atlas->count, capacity);
+	eq(atlas->rows * GLYPH_ATLAS_COLS, capacity);
+	eq(count_chained(font), capacity);
+
+	/* Leave the second glyph the oldest, so the first goes over it */
+	for (i = 0; i < atlas->count; i++) {
+		if (atlas->slots[i].codepoint != OTHER_GLYPH) {
+			require(find_glyph_atlas_slot(font,
+				atlas->slots[i].codepoint) == i);
+		}
+	}
+
+	/* The glyph given up is drawn again, as it was */
+	slot = peek_glyph_atlas_slot(font, OTHER_GLYPH);
+	eq(get_glyph_atlas_slot(window, font, NULL, FIRST_GLYPH), slot);
+	eq(peek_glyph_atlas_slot(font, OTHER_GLYPH), -1);
+	again = read_glyph_atlas_slot(font, slot);
+	notnull(again);
+	require(same_pixels(font, first, again));
+	eq(count_chained(font), capacity);
+
+	mem_free(first);
+	mem_free(other);
+	mem_free(again);
+	ok;
+}
+
+const char *suite_name = "sdl2/atlas";
+struct test tests[] = {
+	{ "grow", test_grow },
+	{ "evict", test_evict },
+	{ NULL, NULL }
+};
@@ -0,0 +1,8 @@
+/* sdl2/quads-fallback
+ *
+ * The checks of sdl2/quads, with the front end drawing a quad at a time as
+ * it does where SDL_RenderGeometry() is not available.
+ */
+
+#define SDL2_NO_GEOMETRY
+#include "quads.c"
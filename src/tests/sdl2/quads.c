@@ -0,0 +1,234 @@
+/* sdl2/quads
+ *
+ * Draw screens of text through the SDL2 front end's term hooks, offscreen
+ * with the software renderer.  Check that what the hooks queue ends up on
+ * the subwindow as drawing each cell straight away would have put it there,
+ * and in a few draw calls a frame where SDL can draw a batch at once.  Run
+ * with -v to see the time per frame.  sdl2/quads-fallback builds this with
+ * SDL2_NO_GEOMETRY, to do the same a quad at a time.
+ */
+
+#include "unit-test.h"
+#include "test-utils.h"
+#include "main-sdl2.c"
+
+#define COLS 80
+#define ROWS 24
+#define FRAMES 60
+
+int setup_tests(void **state) {
+	struct sdlpui_window *window = &g_app.windows[0];
+	struct subwindow *subwindow = &g_app.subwindows[MAIN_SUBWINDOW];
+	SDL_RendererInfo info;
+	struct font *font;
+	char path[1024];
+
+	set_file_paths();
+
+	/* Draw offscreen unless told to use something else */
+	SDL_setenv("SDL_VIDEODRIVER", "dummy", 0);
+	if (SDL_Init(SDL_INIT_VIDEO) != 0) {
+		return 1;
+	}
+	if (TTF_Init() != 0) {
+		SDL_Quit();
+		return 1;
+	}
+
+	font = mem_zalloc(sizeof(*font));
+	path_build(path, sizeof(path), ANGBAND_DIR_FONTS, "8x13x.fon");
+	font->path = string_make(path);
+	font->name = string_make("8x13x.fon");
+	load_font(font);
+
+	init_colors(&g_app);
+	window->app = &g_app;
+	window->wallpaper.mode = WALLPAPER_DONT_SHOW;
+	window->full_rect.w = COLS * font->ttf.glyph.w;
+	window->full_rect.h = ROWS * font->ttf.glyph.h;
+	window->inner_rect = window->full_rect;
+	window->window = SDL_CreateWindow("quads", 0, 0, window->full_rect.w,
+		window->full_rect.h, SDL_WINDOW_HIDDEN);
+	if (window->window) {
+		window->renderer = SDL_CreateRenderer(window->window, -1,
+			SDL_RENDERER_SOFTWARE | SDL_RENDERER_TARGETTEXTURE);
+	}
+	if (!window->renderer || SDL_GetRendererInfo(window->renderer, &info)
+			|| !choose_pixelformat(window, &info)) {
+		if (window->window) {
+			SDL_DestroyWindow(window->window);
+		}
+		free_font(font);
+		TTF_Quit();
+		SDL_Quit();
+		return 1;
+	}
+	make_font_cache(window, font);
+
+	/* The main term, filling the window */
+	subwindow->app = &g_app;
+	subwindow->index = MAIN_SUBWINDOW;
+	subwindow->window = window;
+	subwindow->font = font;
+	subwindow->font_width = font->ttf.glyph.w;
+	subwindow->font_height = font->ttf.glyph.h;
+	subwindow->cols = COLS;
+	subwindow->rows = ROWS;
+	subwindow->full_rect = window->full_rect;
+	subwindow->inner_rect = window->full_rect;
+	subwindow->color = g_app.colors[DEFAULT_SUBWINDOW_BG_COLOR];
+	subwindow->visible = true;
+	subwindow->texture = make_subwindow_texture(window,
+		subwindow->full_rect.w, subwindow->full_rect.h);
+	window->subwindows[MAIN_SUBWINDOW] = subwindow;
+	load_term(subwindow);
+	Term_activate(subwindow->term);
+
+	*state = subwindow;
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	struct subwindow *subwindow = state;
+	struct sdlpui_window *window = subwindow->window;
+
+	Term_activate(NULL);
+	free_subwindow(subwindow);
+#ifdef USE_QUAD_GEOMETRY
+	mem_free(window->vertices);
+	mem_free(window->indices);
+#endif
+	SDL_DestroyRenderer(window->renderer);
+	SDL_DestroyWindow(window->window);
+	TTF_Quit();
+	SDL_Quit();
+	return 0;
+}
+
+/* Fill the term with text which differs from frame to frame, some of it
+ * outside the ASCII cache */
+static void put_frame(int frame) {
+	int x, y;
+
+	for (y = 0; y < ROWS; y++) {
+		for (x = 0; x < COLS; x++) {
+			int n = frame + x + y;
+			wchar_t c = (n % 8) ? L'!' + n % 94 : 0xC0 + (n / 8) % 32;
+
+			Term_putch(x, y, n % BASIC_COLORS, c);
+		}
+	}
+}
+
+/* Read the whole of a texture the size of the window as ARGB8888 */
+static Uint32 *read_texture(const struct sdlpui_window *window,
+		SDL_Texture *texture) {
+	Uint32 *pixels = mem_alloc(window->full_rect.w * window->full_rect.h
+		* sizeof(*pixels));
+
+	SDL_SetRenderTarget(window->renderer, texture);
+	if (SDL_RenderReadPixels(window->renderer, NULL,
+			SDL_PIXELFORMAT_ARGB8888, pixels,
+			window->full_rect.w * sizeof(*pixels)) != 0) {
+		mem_free(pixels);
+		return NULL;
+	}
+	return pixels;
+}
+
+static int test_same(void *state) {
+	struct subwindow *subwindow = state;
+	struct sdlpui_window *window = subwindow->window;
+	SDL_Texture *texture;
+	Uint32 *queued, *direct;
+	int x, y;
+
+	put_frame(0);
+	Term_fresh();
+	queued = read_texture(window, subwindow->texture);
+	notnull(queued);
+
+	/* Draw each cell of the term straight to a texture of its own */
+	texture = make_subwindow_texture(window, subwindow->full_rect.w,
+		subwindow->full_rect.h);
+	render_fill_rect(window, texture, NULL, &subwindow->color);
+	for (y = 0; y < ROWS; y++) {
+		for (x = 0; x < COLS; x++) {
+			int a = Term->scr->a[y][x];
+			SDL_Color fg = g_app.colors[a % MAX_COLORS];
+			SDL_Rect rect = {
+				x * subwindow->font_width,
+				y * subwindow->font_height,
+				subwindow->font_width,
+				subwindow->font_height
+			};
+
+			render_fill_rect(window, texture, &rect,
+				&subwindow->color);
+			render_glyph_mono(window, subwindow->font, texture,
+				rect.x, rect.y, &fg,
+				(uint32_t) Term->scr->c[y][x]);
+		}
+	}
+	direct = read_texture(window, texture);
+	SDL_DestroyTexture(texture);
+	notnull(direct);
+
+	require(!memcmp(queued, direct, window->full_rect.w
+		* window->full_rect.h * sizeof(*queued)));
+	mem_free(queued);
+	mem_free(direct);
+	ok;
+}
+
+static int test_frames(void *state) {
+	struct subwindow *subwindow = state;
+	struct sdlpui_window *window = subwindow->window;
+	int frame;
+
+	/* Once through first, so every glyph is in the atlas */
+	for (frame = 1; frame <= FRAMES; frame++) {
+		put_frame(frame);
+		Term_fresh();
+	}
+
+	window->frame_time = 0;
+	window->frames = 0;
+	window->quads = 0;
+	window->draw_calls = 0;
+	for (frame = 1; frame <= FRAMES; frame++) {
+		put_frame(frame);
+		window->next_redraw = 0;
+		Term_fresh();
+	}
+	require(window->frames > 0);
+
+	/* A glyph for every cell, and at least one fill for every row */
+	require(window->quads >= FRAMES * ROWS * (COLS + 1));
+#ifdef USE_QUAD_GEOMETRY
+	require(window->draw_calls <= FRAMES * QUAD_MAX);
+#else
+	eq(window->draw_calls, window->quads);
+#endif
+
+	if (verbose) {
+		printf("%.3f ms per frame, %lu quads in %lu draw calls  ",
+			1000.0 * (double) window->frame_time
+			/ (double) SDL_GetPerformanceFrequency()
+			/ (double) window->frames,
+			(unsigned long) window->quads,
+			(unsigned long) window->draw_calls);
+	}
+	ok;
+}
+
+#ifdef SDL2_NO_GEOMETRY
+const char *suite_name = "sdl2/quads-fallback";
+#else
+const char *suite_name = "sdl2/quads";
+#endif
+struct test tests[] = {
+	{ "same", test_same },
+	{ "frames", test_frames },
+	{ NULL, NULL }
+};
@@ -0,0 +1,147 @@
+/* ui-term/fresh
+ *
+ * Check that refreshing a term only draws what changed, that rows changed
+ * and then changed back aren't visited at all, and that saving, loading and
+ * resizing keep the contents.
+ */
+
+#include "unit-test.h"
+#include "ui-term.h"
+#include "z-color.h"
+#include "z-virt.h"
+
+#define TERM_WID 40
+#define TERM_HGT 10
+
+/* What the hooks were asked to do since the last reset */
+static int text_calls, text_grids, wipe_grids, frosh_calls;
+
+static errr test_xtra(int n, int v) {
+	if (n == TERM_XTRA_FROSH) frosh_calls++;
+	return 0;
+}
+
+static errr test_curs(int x, int y) {
+	return 0;
+}
+
+static errr test_wipe(int x, int y, int n) {
+	wipe_grids += n;
+	return 0;
+}
+
+static errr test_text(int x, int y, int n, int a, const wchar_t *s) {
+	text_calls++;
+	text_grids += n;
+	return 0;
+}
+
+static void reset_counts(void) {
+	text_calls = text_grids = wipe_grids = frosh_calls = 0;
+}
+
+int setup_tests(void **state) {
+	term *t = mem_zalloc(sizeof(*t));
+
+	term_init(t, TERM_WID, TERM_HGT, 16);
+	t->xtra_hook = test_xtra;
+	t->curs_hook = test_curs;
+	t->wipe_hook = test_wipe;
+	t->text_hook = test_text;
+	Term_activate(t);
+	Term_clear();
+	Term_fresh();
+	*state = t;
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	term *t = state;
+
+	Term_activate(NULL);
+	term_nuke(t);
+	mem_free(t);
+	return 0;
+}
+
+static bool has_char(int x, int y, int a, wchar_t c) {
+	int ga;
+	wchar_t gc;
+
+	return !Term_what(x, y, &ga, &gc) && ga == a && gc == c;
+}
+
+static int test_changed(void *state) {
+	Term_putstr(2, 3, -1, COLOUR_WHITE, "hello");
+	reset_counts();
+	Term_fresh();
+	eq(text_calls, 1);
+	eq(text_grids, 5);
+	eq(frosh_calls, 1);
+
+	/* Only the grid that differs is drawn again */
+	Term_putstr(2, 3, -1, COLOUR_WHITE, "jello");
+	reset_counts();
+	Term_fresh();
+	eq(text_grids, 1);
+
+	/* Nothing changed, nothing drawn */
+	reset_counts();
+	Term_fresh();
+	eq(text_calls, 0);
+	eq(frosh_calls, 0);
+	ok;
+}
+
+static int test_save_load(void *state) {
+	Term_save();
+	Term_putstr(0, 0, -1, COLOUR_RED, "a menu over the top");
+	Term_putstr(0, 1, -1, COLOUR_RED, "a menu over the top");
+	Term_fresh();
+	require(has_char(0, 0, COLOUR_RED, L'a'));
+
+	/* Coming back redraws just the rows the menu covered */
+	Term_load();
+	require(has_char(2, 3, COLOUR_WHITE, L'j'));
+	require(has_char(0, 0, COLOUR_WHITE, L' '));
+	reset_counts();
+	Term_fresh();
+	eq(frosh_calls, 2);
+	eq(text_grids + wipe_grids, 2 * 19);
+
+	/* A save and load with nothing between draws nothing */
+	Term_save();
+	Term_load();
+	reset_counts();
+	Term_fresh();
+	eq(text_calls, 0);
+	eq(wipe_grids, 0);
+	eq(frosh_calls, 0);
+	ok;
+}
+
+static int test_resize(void *state) {
+	Term_putstr(TERM_WID - 3, TERM_HGT - 1, -1, COLOUR_BLUE, "end");
+	Term_fresh();
+	Term_save();
+
+	/* Larger and back keeps what fits, saved screens included */
+	Term_resize(TERM_WID + 7, TERM_HGT + 2);
+	require(has_char(2, 3, COLOUR_WHITE, L'j'));
+	require(has_char(TERM_WID - 1, TERM_HGT - 1, COLOUR_BLUE, L'd'));
+	Term_resize(TERM_WID, TERM_HGT);
+	require(has_char(TERM_WID - 3, TERM_HGT - 1, COLOUR_BLUE, L'e'));
+	Term_putstr(2, 3, -1, COLOUR_WHITE, "xxxxx");
+	Term_load();
+	require(has_char(2, 3, COLOUR_WHITE, L'j'));
+	require(has_char(TERM_WID - 2, TERM_HGT - 1, COLOUR_BLUE, L'n'));
+	ok;
+}
+
+const char *suite_name = "ui-term/fresh";
+struct test tests[] = {
+	{ "changed", test_changed },
+	{ "save_load", test_save_load },
+	{ "resize", test_resize },
+	{ NULL, NULL }
+};
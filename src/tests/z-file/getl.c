@@ -0,0 +1,202 @@
+/* z-file/getl
+ *
+ * Check that reading lines through the read buffer splits them, handles line
+ * ends and expands tabs as reading a byte at a time did, and that positions
+ * allow for what is still in the buffer.
+ */
+
+#include "unit-test.h"
+#include "z-file.h"
+#include "z-virt.h"
+
+#define TEST_FILE "z-file-getl.tmp"
+
+NOSETUP
+NOTEARDOWN
+
+/*
+ * The old file_getl(), reading a byte at a time from memory; the pushed back
+ * byte after a lone CR is handled by not consuming it.
+ */
+static bool ref_getl(const char *text, size_t size, size_t *pos, char *buf,
+		size_t len) {
+	bool seen_cr = false;
+	size_t i = 0;
+	size_t max_len = len - 1;
+
+	while (i < max_len) {
+		char c;
+
+		if (*pos == size) {
+			buf[i] = '\0';
+			return (i == 0) ? false : true;
+		}
+		c = text[(*pos)++];
+		if (c == '\r') {
+			seen_cr = true;
+			continue;
+		}
+		if (seen_cr && c != '\n') {
+			(*pos)--;
+			buf[i] = '\0';
+			return true;
+		}
+		if (c == '\n') {
+			buf[i] = '\0';
+			return true;
+		}
+		if (c == '\t') {
+			size_t tabstop = ((i + 4) / 4) * 4;
+			if (tabstop >= len) break;
+			while (i < tabstop)
+				buf[i++] = ' ';
+			continue;
+		}
+		buf[i++] = c;
+	}
+	buf[i] = '\0';
+	return true;
+}
+
+static bool write_text(const char *text, size_t size) {
+	ang_file *f = file_open(TEST_FILE, MODE_WRITE, FTYPE_TEXT);
+	bool written;
+
+	if (!f) return false;
+	written = file_write(f, text, size);
+	return file_close(f) && written;
+}
+
+/* Read text back with both readers using lines of at most len bytes */
+static bool lines_match(const char *text, size_t size, size_t len) {
+	char *got = mem_alloc(len), *want = mem_alloc(len);
+	ang_file *f = file_open(TEST_FILE, MODE_READ, FTYPE_TEXT);
+	size_t pos = 0;
+	bool more, same = (f != NULL);
+
+	while (same) {
+		more = ref_getl(text, size, &pos, want, len);
+		if (file_getl(f, got, len) != more
+				|| (more && !streq(got, want)))
+			same = false;
+		if (!more) break;
+	}
+	if (f) file_close(f);
+	mem_free(want);
+	mem_free(got);
+	return same;
+}
+
+static int test_endings(void *state) {
+	const char text[] = "unix\ndos\r\nmac\rtwo\r\rcrs\r\r\nend\r\n\n\r"
+		"\tx\ty\t\tz\n  \t\n\r";
+	size_t len;
+
+	require(write_text(text, sizeof(text) - 1));
+	for (len = 2; len < 16; len++)
+		require(lines_match(text, sizeof(text) - 1, len));
+	require(lines_match(text, sizeof(text) - 1, 1024));
+	file_delete(TEST_FILE);
+	ok;
+}
+
+static int test_long(void *state) {
+	size_t size = 100000, i;
+	char *text = mem_alloc(size);
+
+	/* Line ends and tabs falling across the edges of the read buffer */
+	for (i = 0; i < size; i++) {
+		if (i % 1021 == 0) text[i] = '\r';
+		else if (i % 997 == 0) text[i] = '\n';
+		else if (i % 13 == 0) text[i] = '\t';
+		else text[i] = 'a' + i % 26;
+	}
+	require(write_text(text, size));
+	require(lines_match(text, size, 1024));
+	require(lines_match(text, size, 100));
+	require(lines_match(text, size, 5000));
+	file_delete(TEST_FILE);
+	mem_free(text);
+	ok;
+}
+
+static int test_mixed(void *state) {
+	const char text[] = "first\nsecond\nthird\nfourth\n";
+	ang_file *f;
+	char buf[32];
+	uint8_t c;
+
+	require(write_text(text, sizeof(text) - 1));
+	f = file_open(TEST_FILE, MODE_READ, FTYPE_TEXT);
+	require(f);
+
+	/* Other reads carry on from the end of the last line */
+	require(file_getl(f, buf, sizeof(buf)));
+	require(streq(buf, "first"));
+	require(file_readc(f, &c));
+	eq(c, 's');
+	eq(file_read(f, buf, 4), 4);
+	require(!memcmp(buf, "econ", 4));
+	require(file_skip(f, 2));
+	require(file_getl(f, buf, sizeof(buf)));
+	require(streq(buf, "third"));
+	require(file_skip(f, -3));
+	require(file_getl(f, buf, sizeof(buf)));
+	require(streq(buf, "rd"));
+	eq(file_read(f, buf, sizeof(buf)), 7);
+	require(!memcmp(buf, "fourth\n", 7));
+	require(!file_getl(f, buf, sizeof(buf)));
+	file_close(f);
+	file_delete(TEST_FILE);
+	ok;
+}
+
+static int test_tell_seek(void *state) {
+	const char text[] = "first\nsecond\nthird\n";
+	ang_file *f;
+	char buf[32];
+
+	require(write_text(text, sizeof(text) - 1));
+	f = file_open(TEST_FILE, MODE_READ, FTYPE_TEXT);
+	require(f);
+
+	/* Positions count what has been taken from the read buffer */
+	eq(file_tell(f), 0);
+	require(file_getl(f, buf, sizeof(buf)));
+	eq(file_tell(f), 6);
+	require(file_seek(f, 13));
+	require(file_getl(f, buf, sizeof(buf)));
+	require(streq(buf, "third"));
+	require(file_seek(f, 6));
+	require(file_getl(f, buf, sizeof(buf)));
+	require(streq(buf, "second"));
+	eq(file_tell(f), 13);
+	file_close(f);
+
+	/* Going back to patch something already written */
+	f = file_open(TEST_FILE, MODE_WRITE, FTYPE_TEXT);
+	require(f);
+	require(file_write(f, "xxxx5678", 8));
+	eq(file_tell(f), 8);
+	require(file_seek(f, 0));
+	require(file_write(f, "1234", 4));
+	require(file_seek(f, 8));
+	require(file_write(f, "9", 1));
+	file_close(f);
+	f = file_open(TEST_FILE, MODE_READ, FTYPE_TEXT);
+	require(f);
+	require(file_getl(f, buf, sizeof(buf)));
+	require(streq(buf, "123456789"));
+	file_close(f);
+	file_delete(TEST_FILE);
+	ok;
+}
+
+const char *suite_name = "z-file/getl";
+struct test tests[] = {
+	{ "endings", test_endings },
+	{ "long", test_long },
+	{ "mixed", test_mixed },
+	{ "tell_seek", test_tell_seek },
+	{ NULL, NULL }
+};
@@ -1,7 +1,9 @@
 /* z-quark/quark.c */
 
 #include "unit-test.h"
+#include "z-form.h"
 #include "z-quark.h"
+#include "z-virt.h"
 
 int setup_tests(void **state) {
 	quarks_init();
@@ -46,9 +48,40 @@ static int test_dedup(void *state) {
 	ok;
 }
 
+static int test_many(void *state) {
+	const char *first = quark_str(quark_add("2-first"));
+	char buf[32], *big = mem_alloc(10000);
+	quark_t qs[2000], q;
+	int i;
+
+	for (i = 0; i < 2000; i++) {
+		strnfmt(buf, sizeof(buf), "2-%d", i);
+		qs[i] = quark_add(buf);
+	}
+	memset(big, 'x', 9999);
+	big[9999] = '\0';
+	q = quark_add(big);
+
+	/* Strings already handed out do not move */
+	require(quark_str(quark_add("2-first")) == first);
+	require(streq(first, "2-first"));
+
+	for (i = 0; i < 2000; i++) {
+		strnfmt(buf, sizeof(buf), "2-%d", i);
+		require(quark_add(buf) == qs[i]);
+		require(streq(quark_str(qs[i]), buf));
+	}
+	require(quark_add(big) == q);
+	require(streq(quark_str(q), big));
+	null(quark_str(q + 1));
+	mem_free(big);
+	ok;
+}
+
 const char *suite_name = "z-quark/quark";
 struct test tests[] = {
 	{ "alloc", test_alloc },
 	{ "dedup", test_dedup },
+	{ "many", test_many },
 	{ NULL, NULL }
 };
@@ -0,0 +1,103 @@
+/* z-strmap/strmap.c */
+
+#include "unit-test.h"
+#include "z-form.h"
+#include "z-strmap.h"
+
+NOSETUP
+NOTEARDOWN
+
+static int test_add_get(void *state) {
+	struct strmap *m = strmap_new(false);
+	int a = 1, b = 2;
+
+	require(strmap_add(m, "Foo", &a));
+	require(strmap_add(m, "foo", &b));
+	ptreq(strmap_get(m, "Foo"), &a);
+	ptreq(strmap_get(m, "foo"), &b);
+	null(strmap_get(m, "FOO"));
+	null(strmap_get(m, ""));
+	eq(strmap_len(m), 2);
+
+	/* The first value for a key is kept */
+	require(!strmap_add(m, "Foo", &b));
+	ptreq(strmap_get(m, "Foo"), &a);
+	eq(strmap_len(m), 2);
+	strmap_free(m);
+	ok;
+}
+
+static int test_nocase(void *state) {
+	struct strmap *m = strmap_new(true);
+	int a = 1;
+
+	require(strmap_add(m, "Potion of Speed", &a));
+	ptreq(strmap_get(m, "potion of speed"), &a);
+	ptreq(strmap_get(m, "POTION OF SPEED"), &a);
+	null(strmap_get(m, "Potion of Spee"));
+	require(!strmap_add(m, "potion OF speed", &a));
+	eq(strmap_len(m), 1);
+	strmap_free(m);
+	ok;
+}
+
+static int test_grow(void *state) {
+	struct strmap *m = strmap_new(false);
+	char key[32];
+	int vals[1000], i;
+
+	for (i = 0; i < 1000; i++) {
+		strnfmt(key, sizeof(key), "key %d", i);
+		require(strmap_add(m, key, &vals[i]));
+	}
+	eq(strmap_len(m), 1000);
+	for (i = 0; i < 1000; i++) {
+		strnfmt(key, sizeof(key), "key %d", i);
+		ptreq(strmap_get(m, key), &vals[i]);
+	}
+	null(strmap_get(m, "key 1000"));
+	strmap_free(m);
+	ok;
+}
+
+static int test_remove(void *state) {
+	struct strmap *m = strmap_new(false);
+	char key[32];
+	int vals[500], i;
+
+	for (i = 0; i < 500; i++) {
+		strnfmt(key, sizeof(key), "key %d", i);
+		require(strmap_add(m, key, &vals[i]));
+	}
+
+	/* Take out every third, leaving the others reachable */
+	for (i = 0; i < 500; i += 3) {
+		strnfmt(key, sizeof(key), "key %d", i);
+		ptreq(strmap_remove(m, key), &vals[i]);
+		null(strmap_remove(m, key));
+	}
+	eq(strmap_len(m), 500 - 167);
+	for (i = 0; i < 500; i++) {
+		strnfmt(key, sizeof(key), "key %d", i);
+		if (i % 3) {
+			ptreq(strmap_get(m, key), &vals[i]);
+		} else {
+			null(strmap_get(m, key));
+		}
+	}
+
+	/* Keys can go back in */
+	require(strmap_add(m, "key 0", &vals[1]));
+	ptreq(strmap_get(m, "key 0"), &vals[1]);
+	strmap_free(m);
+	ok;
+}
+
+const char *suite_name = "z-strmap/strmap";
+struct test tests[] = {
+	{ "add_get", test_add_get },
+	{ "nocase", test_nocase },
+	{ "grow", test_grow },
+	{ "remove", test_remove },
+	{ NULL, NULL }
+};
@@ -0,0 +1 @@
+TESTPROGS += z-strmap/strmap
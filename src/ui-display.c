@@ -897,8 +897,11 @@ static void update_sidebar(game_event_type type, game_event_data *data,
 static void hp_colour_change(game_event_type type, game_event_data *data,
 							 void *user)
 {
-	if ((OPT(player, hp_changes_color)) && (use_graphics == GRAPHICS_NONE))
-		square_light_spot(cave, player->grid);
+	if ((OPT(player, hp_changes_color)) && (use_graphics == GRAPHICS_NONE)) {
+		/* Draw it now, as this comes after the marked grids are drawn */
+		square_mark_redraw(cave, player->grid);
+		prt_map_grids();
+	}
 }
 
 
@@ -1334,7 +1337,9 @@ static void update_statusline(game_event_type type, game_event_data *data, void
 static void trace_map_updates(game_event_type type, game_event_data *data,
 							  void *user)
 {
-	if (data->point.x == -1 && data->point.y == -1)
+	if (!data)
+		printf("Redraw marked grids\n");
+	else if (data->point.x == -1 && data->point.y == -1)
 		printf("Redraw whole map\n");
 	else
 		printf("Redraw (%i, %i)\n", data->point.x, data->point.y);
@@ -1342,66 +1347,26 @@ static void trace_map_updates(game_event_type type, game_event_data *data,
 #endif
 
 /**
- * Update either a single map grid or a whole map
+ * Update the map grids marked as changed, a single map grid or the whole map
  */
 static void update_maps(game_event_type type, game_event_data *data, void *user)
 {
 	term *t = user;
 
-	/* This signals a whole-map redraw. */
-	if (data->point.x == -1 && data->point.y == -1)
+	if (!data) {
+		/* This signals that grids have been marked as changed. */
+		prt_map_grids();
+	} else if (data->point.x == -1 && data->point.y == -1) {
+		/* This signals a whole-map redraw. */
 		prt_map();
+	} else {
+		/* Single point to be redrawn, in all the maps at once */
+		struct loc grid = loc(data->point.x, data->point.y);
 
-	/* Single point to be redrawn */
-	else {
-		struct grid_data g;
-		int a, ta;
-		wchar_t c, tc;
-
-		int ky, kx;
-		int vy, vx;
-		int clipy;
-
-		/* Location relative to panel */
-		ky = data->point.y - t->offset_y;
-		kx = data->point.x - t->offset_x;
-
-		if (t == angband_term[0]) {
-			/* Verify location */
-			if ((ky < 0) || (ky >= SCREEN_HGT)) return;
-			if ((kx < 0) || (kx >= SCREEN_WID)) return;
-
-			/* Location in window */
-			vy = tile_height * ky + ROW_MAP;
-			vx = tile_width * kx + COL_MAP;
-
-			/* Protect the status line against modification. */
-			clipy = ROW_MAP + SCREEN_ROWS;
-		} else {
-			/* Verify location */
-			if ((ky < 0) || (ky >= t->hgt / tile_height)) return;
-			if ((kx < 0) || (kx >= t->wid / tile_width)) return;
-
-			/* Location in window */
-			vy = tile_height * ky;
-			vx = tile_width * kx;
-
-			/* All the rows may be used for the map. */
-			clipy = t->hgt;
+		if (square_in_bounds(cave, grid)) {
+			square_mark_redraw(cave, grid);
+			prt_map_grids();
 		}
-
-
-		/* Redraw the grid spot */
-		map_info(data->point, &g);
-		grid_data_as_text(&g, &a, &c, &ta, &tc);
-		Term_queue_char(t, vx, vy, a, c, ta, tc);
-#ifdef MAP_DEBUG
-		/* Plot 'spot' updates in light green to make them visible */
-		Term_queue_char(t, vx, vy, COLOUR_L_GREEN, c, ta, tc);
-#endif
-
-		if ((tile_width > 1) || (tile_height > 1))
-			Term_big_queue_char(t, vx, vy, clipy, a, c, COLOUR_WHITE, L' ');
 	}
 
 	/* Refresh the main screen unless the map needs to center */
@@ -2542,7 +2507,7 @@ static void new_level_display_update(game_event_type type,
 
 	/* If autosave is pending, do it now. */
 	if (player->upkeep->autosave) {
-		save_game();
+		autosave_game();
 		player->upkeep->autosave = false;
 	}
 
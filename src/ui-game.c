@@ -508,6 +508,19 @@ size_t cmd_list_lookup_by_name(const char *name)
 }
 
 
+/**
+ * Say so if an autosave written in the background has failed
+ */
+static void check_autosave(void)
+{
+	bool ok;
+
+	if (savefile_poll(&ok) && !ok) {
+		msg("Failed to write the autosave!");
+		event_signal(EVENT_MESSAGE_FLUSH);
+	}
+}
+
 /**
  * Parse and execute the current command
  * Give "Warning" on illegal commands.
@@ -516,11 +529,14 @@ void textui_process_command(void)
 {
 	int count = 0;
 	bool done = true;
-	ui_event e = textui_get_command(&count);
+	ui_event e;
 	struct cmd_info *cmd = NULL;
 	unsigned char key = '\0';
 	int mode = OPT(player, rogue_like_commands) ? KEYMAP_MODE_ROGUE : KEYMAP_MODE_ORIG;
 
+	check_autosave();
+	e = textui_get_command(&count);
+
 	switch (e.type) {
 		case EVT_RESIZE: do_cmd_redraw(); return;
 		case EVT_MOUSE: textui_process_click(e); return;
@@ -1019,11 +1035,12 @@ void save_game(void)
 }
 
 /**
- * Save the game.
+ * Save the game, or take it to be saved while play carries on if background
+ * is true.
  *
  * \return whether the save was successful.
  */
-bool save_game_checked(void)
+static bool save_game_aux(bool background)
 {
 	char path[1024];
 	bool result;
@@ -1050,8 +1067,10 @@ bool save_game_checked(void)
 	signals_ignore_tstp();
 
 	/* Save the player */
-	if (savefile_save(savefile)) {
-		prt("Saving game... done.", 0, 0);
+	if (background ? savefile_save_background(savefile) :
+			savefile_save(savefile)) {
+		/* One still being written is reported on by check_autosave() */
+		if (!background) prt("Saving game... done.", 0, 0);
 		result = true;
 	} else {
 		prt("Saving game... failed!", 0, 0);
@@ -1087,6 +1106,30 @@ bool save_game_checked(void)
 	return result;
 }
 
+/**
+ * Save the game.
+ *
+ * \return whether the save was successful.
+ */
+bool save_game_checked(void)
+{
+	return save_game_aux(false);
+}
+
+/**
+ * Save the game for an autosave, writing the savefile while play carries on.
+ */
+void autosave_game(void)
+{
+	/* Report if the last one couldn't be written */
+	if (!savefile_wait()) {
+		msg("Failed to write the last autosave!");
+		event_signal(EVENT_MESSAGE_FLUSH);
+	}
+
+	(void) save_game_aux(true);
+}
+
 
 /**
  * Close up the current game (player may or may not be dead).
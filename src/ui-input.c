@@ -378,6 +378,9 @@ static void msg_flush(int x)
 {
 	uint8_t a = COLOUR_L_BLUE;
 
+	/* Show the map as it is when the message is read */
+	if (character_dungeon && textui_map_is_visible()) prt_map_grids();
+
 	/* Pause for response */
 	Term_putstr(x, 0, -1, a, "-more-");
 
@@ -24,6 +24,7 @@
 #include "effects-info.h"
 #include "game-input.h"
 #include "game-world.h"
+#include "generate.h"
 #include "grafmode.h"
 #include "init.h"
 #include "mon-init.h"
@@ -1513,6 +1514,9 @@ static struct object *find_artifact(struct artifact *artifact)
 		int j;
 		if (strstr(c->name, "known")) continue;
 
+		/* Bring the level back from the store if it is packed away */
+		if (c->pack) c = chunk_find_name(c->name);
+
 		/* Ground objects */
 		for (y = 1; y < c->height; y++) {
 			for (x = 1; x < c->width; x++) {
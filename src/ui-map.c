@@ -612,12 +612,156 @@ void print_rel(wchar_t c, uint8_t a, int y, int x)
 }
 
 
-static void prt_map_aux(void)
+/**
+ * A window showing the map grid for grid
+ */
+struct map_view {
+	term *t;
+	struct loc tl;		/**< Top left grid shown */
+	struct loc br;		/**< Bottom right grid shown */
+	int vx, vy;		/**< Where in the window the top left grid goes */
+	int clipy;		/**< First row big tiles can't pad into */
+	bool sub;		/**< Whether it is a subwindow */
+};
+
+/**
+ * Find the main screen and the subwindows which show the map grid for grid,
+ * returning how many there are
+ */
+static int get_map_views(struct map_view *views)
 {
-	int a, ta;
-	wchar_t c, tc;
-	struct grid_data g;
+	int n = 0;
+	int j;
+
+	/* The main screen */
+	views[n].t = Term;
+	views[n].tl = loc(Term->offset_x, Term->offset_y);
+	views[n].br = loc(Term->offset_x + SCREEN_WID - 1,
+		Term->offset_y + SCREEN_HGT - 1);
+	views[n].vx = COL_MAP;
+	views[n].vy = ROW_MAP;
+
+	/* Avoid overwriting the last row with padding for big tiles. */
+	views[n].clipy = ROW_MAP + SCREEN_ROWS;
+	views[n].sub = false;
+	n++;
+
+	/* Scan windows */
+	for (j = 0; j < ANGBAND_TERM_MAX; j++) {
+		term *t = angband_term[j];
+
+		/* No window, or no relevant flags */
+		if (!t || t == Term) continue;
+		if (!(window_flag[j] & (PW_MAPS))) continue;
+
+		/* Small-scale maps are drawn whole */
+		if (window_flag[j] & PW_MAP) continue;
+
+		views[n].t = t;
+		views[n].tl = loc(t->offset_x, t->offset_y);
+		views[n].br = loc(t->offset_x + t->wid / tile_width - 1,
+			t->offset_y + t->hgt / tile_height - 1);
+		views[n].vx = 0;
+		views[n].vy = 0;
+
+		/*
+		 * The overhead view can use the last row of the terminal.
+		 * Others can not.
+		 */
+		views[n].clipy = t->hgt -
+			((window_flag[j] & PW_OVERHEAD) ? 0 : ROW_BOTTOM_MAP);
+		views[n].sub = true;
+		n++;
+	}
+
+	return n;
+}
+
+/**
+ * Draw the map grids marked as changed in every window showing the map
+ * grid for grid, working out what is in each grid just once, and forget
+ * the marks.
+ */
+void prt_map_grids(void)
+{
+	struct map_view views[ANGBAND_TERM_MAX + 1];
+	int n, i, first;
+	struct loc grid;
+
+	if (!cave || !player || !player->cave) return;
+	if (!cave_redraw_pending(cave)) return;
+
+	n = get_map_views(views);
+
+	/* Leave the main screen alone while something covers the map */
+	first = textui_map_is_visible() ? 0 : 1;
+	for (grid.y = cave->redraw_tl.y; grid.y <= cave->redraw_br.y;
+			grid.y++) {
+		for (grid.x = cave->redraw_tl.x; grid.x <= cave->redraw_br.x;
+				grid.x++) {
+			struct grid_data g;
+			int a, ta;
+			wchar_t c, tc;
+			bool looked = false;
+
+			if (!square_isredraw(cave, grid)) continue;
+
+			for (i = first; i < n; i++) {
+				struct map_view *v = &views[i];
+				int vx, vy;
+
+				/* Not in this window */
+				if (grid.x < v->tl.x || grid.x > v->br.x ||
+						grid.y < v->tl.y ||
+						grid.y > v->br.y) {
+					continue;
+				}
+
+				/* Determine what is there */
+				if (!looked) {
+					map_info(grid, &g);
+					grid_data_as_text(&g, &a, &c, &ta, &tc);
+					looked = true;
+				}
+
+				/* Location in window */
+				vx = v->vx + tile_width * (grid.x - v->tl.x);
+				vy = v->vy + tile_height * (grid.y - v->tl.y);
+
+				/* Queue it */
+				Term_queue_char(v->t, vx, vy, a, c, ta, tc);
+#ifdef MAP_DEBUG
+				/* Plot updates in light green to make them
+				 * visible */
+				Term_queue_char(v->t, vx, vy, COLOUR_L_GREEN, c,
+					ta, tc);
+#endif
+
+				if ((tile_width > 1) || (tile_height > 1)) {
+					if (v->sub) {
+						Term_big_queue_char(v->t, vx,
+							vy, v->clipy, 255, -1,
+							0, 0);
+					} else {
+						Term_big_queue_char(v->t, vx,
+							vy, v->clipy, a, c,
+							COLOUR_WHITE, L' ');
+					}
+				}
+			}
+		}
+	}
 
+	cave_clear_redraw(cave);
+}
+
+/**
+ * Redraw the parts of the map subwindows which aren't grids of the level:
+ * the small-scale maps, what lies beyond the edges of the level, and any
+ * partial tiles.
+ */
+static void prt_map_aux(void)
+{
 	int y, x;
 	int vy, vx;
 	int ty, tx;
@@ -654,29 +798,18 @@ static void prt_map_aux(void)
 		 */
 		clipy = t->hgt - ((window_flag[j] & PW_OVERHEAD) ? 0 : ROW_BOTTOM_MAP);
 
-		/* Dump the map */
+		/* Blank what is beyond the level */
 		for (y = t->offset_y, vy = 0; y < ty; vy += tile_height, y++) {
 			for (x = t->offset_x, vx = 0; x < tx; vx += tile_width, x++) {
 				/* Check bounds */
-				if (!square_in_bounds(cave, loc(x, y))) {
-					Term_queue_char(t, vx, vy,
-						COLOUR_WHITE, ' ',
-						0, 0);
-					if (tile_width > 1 || tile_height > 1) {
-						Term_big_queue_char(t, vx, vy,
-							clipy, COLOUR_WHITE, ' ', 0, 0);
-					}
-					continue;
-				}
+				if (square_in_bounds(cave, loc(x, y))) continue;
 
-				/* Determine what is there */
-				map_info(loc(x, y), &g);
-				grid_data_as_text(&g, &a, &c, &ta, &tc);
-				Term_queue_char(t, vx, vy, a, c, ta, tc);
-
-				if ((tile_width > 1) || (tile_height > 1))
+				Term_queue_char(t, vx, vy, COLOUR_WHITE, ' ',
+					0, 0);
+				if (tile_width > 1 || tile_height > 1) {
 					Term_big_queue_char(t, vx, vy, clipy,
-						255, -1, 0, 0);
+						COLOUR_WHITE, ' ', 0, 0);
+				}
 			}
 			/* Clear partial tile at the end of each line. */
 			for (; vx < t->wid; ++vx) {
@@ -694,53 +827,36 @@ static void prt_map_aux(void)
 	}
 }
 
-
-
 /**
- * Redraw (on the screen) the current map panel
- *
- * Note the inline use of "light_spot()" for efficiency.
- *
- * The main screen will always be at least 24x80 in size.
+ * Redraw the whole map: every grid in view is marked as changed and drawn
+ * as for any other change.
  */
 void prt_map(void)
 {
-	int a, ta;
-	wchar_t c, tc;
-	struct grid_data g;
+	struct map_view views[ANGBAND_TERM_MAX + 1];
+	int n, i;
 
-	int y, x;
-	int vy, vx;
-	int ty, tx;
-	int clipy;
-
-	/* Redraw map sub-windows */
+	/* Redraw the rest of the map sub-windows */
 	prt_map_aux();
 
-	/* Assume screen */
-	ty = Term->offset_y + SCREEN_HGT;
-	tx = Term->offset_x + SCREEN_WID;
-
-	/* Avoid overwriting the last row with padding for big tiles. */
-	clipy = ROW_MAP + SCREEN_ROWS;
-
-	/* Dump the map */
-	for (y = Term->offset_y, vy = ROW_MAP; y < ty; vy += tile_height, y++)
-		for (x = Term->offset_x, vx = COL_MAP; x < tx; vx += tile_width, x++) {
-			/* Check bounds */
-			if (!square_in_bounds(cave, loc(x, y))) continue;
-
-			/* Determine what is there */
-			map_info(loc(x, y), &g);
-			grid_data_as_text(&g, &a, &c, &ta, &tc);
-
-			/* Queue it */
-			Term_queue_char(Term, vx, vy, a, c, ta, tc);
-
-			if ((tile_width > 1) || (tile_height > 1))
-				Term_big_queue_char(Term, vx, vy, clipy, a, c,
-					COLOUR_WHITE, L' ');
+	/* Mark every grid in view */
+	n = get_map_views(views);
+	for (i = 0; i < n; i++) {
+		struct loc grid;
+		int x1 = MAX(views[i].tl.x, 0);
+		int y1 = MAX(views[i].tl.y, 0);
+		int x2 = MIN(views[i].br.x, cave->width - 1);
+		int y2 = MIN(views[i].br.y, cave->height - 1);
+
+		for (grid.y = y1; grid.y <= y2; grid.y++) {
+			for (grid.x = x1; grid.x <= x2; grid.x++) {
+				square_mark_redraw(cave, grid);
+			}
 		}
+	}
+
+	/* Draw them */
+	prt_map_grids();
 }
 
 /**
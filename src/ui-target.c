@@ -401,7 +401,7 @@ static ui_event target_recall_loop_object(struct object *obj, int y, int x,
 				strnfmt(out_val, TARGET_OUT_VAL_SIZE,
 						"%s%s%s%s, %s (%d:%d, noise=%d, scent=%d).", s1, s2, s3,
 						o_name, coords, y, x, (int)cave->noise.grids[y][x],
-						(int)cave->scent.grids[y][x]);
+						square_scent(cave, loc(x, y)));
 			} else {
 				strnfmt(out_val, TARGET_OUT_VAL_SIZE,
 						"%s%s%s%s, %s.", s1, s2, s3, o_name, coords);
@@ -490,7 +490,7 @@ static bool aux_hallucinate(struct chunk *c, struct player *p,
 			auxst->grid.y,
 			auxst->grid.x,
 			(int)c->noise.grids[auxst->grid.y][auxst->grid.x],
-			(int)c->scent.grids[auxst->grid.y][auxst->grid.x]);
+			square_scent(c, auxst->grid));
 	} else {
 		strnfmt(out_val, sizeof(out_val), "%s%s%s, %s.",
 			auxst->phrase1,
@@ -567,7 +567,7 @@ static bool aux_monster(struct chunk *c, struct player *p,
 					auxst->grid.y,
 					auxst->grid.x,
 					(int)c->noise.grids[auxst->grid.y][auxst->grid.x],
-					(int)c->scent.grids[auxst->grid.y][auxst->grid.x]);
+					square_scent(c, auxst->grid));
 			} else {
 				strnfmt(out_val, sizeof(out_val),
 					"%s%s%s (%s), %s.",
@@ -653,7 +653,7 @@ static bool aux_monster(struct chunk *c, struct player *p,
 				auxst->grid.y,
 				auxst->grid.x,
 				(int)c->noise.grids[auxst->grid.y][auxst->grid.x],
-				(int)c->scent.grids[auxst->grid.y][auxst->grid.x]);
+				square_scent(c, auxst->grid));
 
 			prt(out_val, 0, 0);
 			move_cursor_relative(auxst->grid.y, auxst->grid.x);
@@ -725,7 +725,7 @@ static bool aux_trap(struct chunk *c, struct player *p,
 				auxst->grid.y,
 				auxst->grid.x,
 				(int)c->noise.grids[auxst->grid.y][auxst->grid.x],
-				(int)c->scent.grids[auxst->grid.y][auxst->grid.x]);
+				square_scent(c, auxst->grid));
 		} else {
 			strnfmt(out_val, sizeof(out_val), "%s%s%s%s, %s.",
 				auxst->phrase1,
@@ -797,7 +797,7 @@ static bool aux_object(struct chunk *c, struct player *p,
 					auxst->grid.y,
 					auxst->grid.x,
 					(int)c->noise.grids[auxst->grid.y][auxst->grid.x],
-					(int)c->scent.grids[auxst->grid.y][auxst->grid.x]);
+					square_scent(c, auxst->grid));
 			} else {
 				strnfmt(out_val, sizeof(out_val),
 					"%s%sa pile of %d objects, %s.",
@@ -923,7 +923,7 @@ static bool aux_terrain(struct chunk *c, struct player *p,
 			auxst->grid.y,
 			auxst->grid.x,
 			(int)c->noise.grids[auxst->grid.y][auxst->grid.x],
-			(int)c->scent.grids[auxst->grid.y][auxst->grid.x]);
+			square_scent(c, auxst->grid));
 	} else {
 		strnfmt(out_val, sizeof(out_val),
 			"%s%s%s%s, %s.",
@@ -370,6 +370,9 @@ static errr term_win_init(term_win *s, int w, int h)
 	s->vta = mem_zalloc_alt(h * w * sizeof(int));
 	s->vtc = mem_zalloc_alt(h * w * sizeof(wchar_t));
 
+	/* Remember the row length */
+	s->w = w;
+
 	/* Prepare the window access arrays */
 	for (y = 0; y < h; y++) {
 		s->a[y] = s->va + w * y;
@@ -389,28 +392,20 @@ static errr term_win_init(term_win *s, int w, int h)
  */
 static errr term_win_copy(term_win *s, term_win *f, int w, int h)
 {
-	int x, y;
-
-	/* Copy contents */
-	for (y = 0; y < h; y++) {
-		int *f_aa = f->a[y];
-		wchar_t *f_cc = f->c[y];
-
-		int *s_aa = s->a[y];
-		wchar_t *s_cc = s->c[y];
-
-		int *f_taa = f->ta[y];
-		wchar_t *f_tcc = f->tc[y];
-
-		int *s_taa = s->ta[y];
-		wchar_t *s_tcc = s->tc[y];
-
-		for (x = 0; x < w; x++) {
-			*s_aa++ = *f_aa++;
-			*s_cc++ = *f_cc++;
+	int y;
 
-			*s_taa++ = *f_taa++;
-			*s_tcc++ = *f_tcc++;
+	/* Copy contents, all at once if the rows line up */
+	if (s->w == w && f->w == w) {
+		memcpy(s->va, f->va, h * w * sizeof(int));
+		memcpy(s->vc, f->vc, h * w * sizeof(wchar_t));
+		memcpy(s->vta, f->vta, h * w * sizeof(int));
+		memcpy(s->vtc, f->vtc, h * w * sizeof(wchar_t));
+	} else {
+		for (y = 0; y < h; y++) {
+			memcpy(s->a[y], f->a[y], w * sizeof(int));
+			memcpy(s->c[y], f->c[y], w * sizeof(wchar_t));
+			memcpy(s->ta[y], f->ta[y], w * sizeof(int));
+			memcpy(s->tc[y], f->tc[y], w * sizeof(wchar_t));
 		}
 	}
 
@@ -1561,6 +1556,27 @@ static void Term_fresh_row_text(int y, int x1, int x2)
 	}
 }
 
+/**
+ * Check whether any grid in a "modified" run of a row differs from what is
+ * displayed, comparing the whole run at once rather than grid by grid.  The
+ * terrain need only be compared when it is drawn (see "Term_fresh").
+ */
+static bool Term_fresh_row_changed(int y, int x1, int x2, bool terrain)
+{
+	term_win *old = Term->old;
+	term_win *scr = Term->scr;
+	size_t n = x2 - x1 + 1;
+
+	if (memcmp(old->a[y] + x1, scr->a[y] + x1, n * sizeof(int)) ||
+			memcmp(old->c[y] + x1, scr->c[y] + x1,
+			n * sizeof(wchar_t))) {
+		return true;
+	}
+	return terrain &&
+		(memcmp(old->ta[y] + x1, scr->ta[y] + x1, n * sizeof(int)) ||
+		memcmp(old->tc[y] + x1, scr->tc[y] + x1, n * sizeof(wchar_t)));
+}
+
 /**
  * Mark a spot as needing refresh (see "Term_fresh")
  */
@@ -1882,6 +1898,18 @@ errr Term_fresh(void)
 				Term->x1[y] = w;
 				Term->x2[y] = 0;
 
+				/*
+				 * Skip rows which were changed and then changed
+				 * back, as after "Term_load()"; not when big or
+				 * double-height tiles may need their neighbours
+				 * redrawn.
+				 */
+				if (!pr_drw && !Term->higher_pict &&
+						!Term_fresh_row_changed(y, x1, x2,
+						Term->always_pict)) {
+					continue;
+				}
+
 				/* Use "Term_pict()" - always, sometimes or never */
 				if (Term->always_pict) {
 					/* Flush the row */
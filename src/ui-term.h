@@ -27,11 +27,16 @@
  *	- Array[h*w] -- Attribute array
  *	- Array[h*w] -- Character array
  *
+ *	- Row length of the arrays
+ *
  *	- next screen saved
  *	- hook to be called on screen size change
  *
  * Note that the attr/char pair at (x,y) is a[y][x]/c[y][x]
  * and that the row of attr/chars at (0,y) is a[y]/c[y]
+ *
+ * The rows follow one another in va/vc (and vta/vtc for the terrain), so a
+ * whole window, or a run of any row, can be copied or compared at once.
  */
 
 typedef struct term_win term_win;
@@ -54,6 +59,8 @@ struct term_win
 	int *vta;
 	wchar_t *vtc;
 
+	int w;
+
 	term_win *next;
 };
 
@@ -1155,7 +1155,10 @@ static bool stats_monster(struct monster *mon, int i)
 		uniq_total[lvl] += addval;
 
 		/* kill the unique if we're in clearing mode */
-		if (clearing) mon->race->max_num = 0;
+		if (clearing) {
+			mon->race->max_num = 0;
+			invalidate_mon_num_tables();
+		}
 
 		/* debugging print that we killed it
 		   msg_format("Killed %s",race->name); */
@@ -1487,6 +1490,7 @@ static void revive_uniques(void)
 		/* Revive the unique monster */
 		if (rf_has(race->flags, RF_UNIQUE)) race->max_num = 1;
 	}
+	invalidate_mon_num_tables();
 }
 
 /**
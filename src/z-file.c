@@ -820,11 +820,21 @@ FILE *fdopen(int handle, const char *mode);
 #endif
 
 /* Private structure to hold file pointers and useful info. */
+/**
+ * Text read a line at a time goes through a buffer of FILE_BUF_SIZE bytes,
+ * which is only allocated on the first call to file_getl().  The other
+ * reading functions take what is left in it before reading more.
+ */
+#define FILE_BUF_SIZE 16384
+
 struct ang_file
 {
 	FILE *fh;
 	char *fname;
 	file_mode mode;
+	char *rbuf;
+	size_t rpos;
+	size_t rlen;
 };
 
 
@@ -1030,6 +1040,22 @@ ang_file *file_open(const char *fname, file_mode mode, file_type ftype)
 }
 
 
+/**
+ * Create a temporary file for reading and writing.
+ */
+ang_file *file_temp(void)
+{
+	ang_file *f;
+	FILE *fh = tmpfile();
+
+	if (!fh) return NULL;
+	f = mem_zalloc(sizeof(ang_file));
+	f->fh = fh;
+	f->mode = MODE_WRITE;
+	return f;
+}
+
+
 /**
  * Close file handle 'f'.
  */
@@ -1038,6 +1064,7 @@ bool file_close(ang_file *f)
 	if (fclose(f->fh) != 0)
 		return false;
 
+	mem_free(f->rbuf);
 	mem_free(f->fname);
 	mem_free(f);
 
@@ -1088,7 +1115,37 @@ void file_unlock(ang_file *f)
  */
 bool file_skip(ang_file *f, int bytes)
 {
-	return (fseek(f->fh, bytes, SEEK_CUR) == 0);
+	size_t avail = f->rlen - f->rpos;
+
+	/* Stay in the buffer if we can */
+	if (bytes >= 0 && (size_t)bytes <= avail) {
+		f->rpos += bytes;
+		return true;
+	}
+
+	/* The file is ahead of us by what is left in the buffer */
+	f->rpos = f->rlen = 0;
+	return (fseek(f->fh, bytes - (long)avail, SEEK_CUR) == 0);
+}
+
+/**
+ * Return the position in file 'f', or -1 on error.
+ */
+long file_tell(ang_file *f)
+{
+	long pos = ftell(f->fh);
+
+	/* Bytes still in the buffer have not been read yet */
+	return (pos < 0) ? pos : pos - (long)(f->rlen - f->rpos);
+}
+
+/**
+ * Move to position 'pos' in file 'f'.
+ */
+bool file_seek(ang_file *f, long pos)
+{
+	f->rpos = f->rlen = 0;
+	return (fseek(f->fh, pos, SEEK_SET) == 0);
 }
 
 /**
@@ -1096,7 +1153,14 @@ bool file_skip(ang_file *f, int bytes)
  */
 bool file_readc(ang_file *f, uint8_t *b)
 {
-	int i = fgetc(f->fh);
+	int i;
+
+	if (f->rpos < f->rlen) {
+		*b = (uint8_t)f->rbuf[f->rpos++];
+		return true;
+	}
+
+	i = fgetc(f->fh);
 
 	if (i == EOF)
 		return false;
@@ -1118,12 +1182,20 @@ bool file_writec(ang_file *f, uint8_t b)
  */
 int file_read(ang_file *f, char *buf, size_t n)
 {
-	size_t read = fread(buf, 1, n, f->fh);
+	size_t read = MIN(n, f->rlen - f->rpos);
 
-	if (read == 0 && ferror(f->fh))
-		return -1;
-	else
-		return read;
+	if (read) {
+		memcpy(buf, f->rbuf + f->rpos, read);
+		f->rpos += read;
+	}
+	if (read < n) {
+		size_t more = fread(buf + read, 1, n - read, f->fh);
+
+		if (more == 0 && read == 0 && ferror(f->fh))
+			return -1;
+		read += more;
+	}
+	return read;
 }
 
 /**
@@ -1134,8 +1206,41 @@ bool file_write(ang_file *f, const char *buf, size_t n)
 	return fwrite(buf, 1, n, f->fh) == n;
 }
 
+/**
+ * Write out anything buffered for file 'f'.
+ */
+bool file_flush(ang_file *f)
+{
+	return fflush(f->fh) == 0;
+}
+
+bool file_sync(ang_file *f)
+{
+	if (fflush(f->fh) != 0) return false;
+#if defined(WINDOWS) && !defined(CYGWIN)
+	return _commit(_fileno(f->fh)) == 0;
+#elif defined(UNIX)
+	return fsync(fileno(f->fh)) == 0;
+#else
+	return true;
+#endif
+}
+
 /** Line-based IO **/
 
+/**
+ * Refill the read buffer of 'f' once it is empty.  Returns false at the end
+ * of the file.
+ */
+static bool file_fill(ang_file *f)
+{
+	if (f->rpos < f->rlen) return true;
+	if (!f->rbuf) f->rbuf = mem_alloc(FILE_BUF_SIZE);
+	f->rpos = 0;
+	f->rlen = fread(f->rbuf, 1, FILE_BUF_SIZE, f->fh);
+	return f->rlen > 0;
+}
+
 /**
  * Read a line of text from file 'f' into buffer 'buf' of size 'n' bytes.
  *
@@ -1149,7 +1254,6 @@ bool file_write(ang_file *f, const char *buf, size_t n)
 bool file_getl(ang_file *f, char *buf, size_t len)
 {
 	bool seen_cr = false;
-	uint8_t b;
 	size_t i = 0;
 
 	/* Leave a byte for the terminating 0 */
@@ -1158,12 +1262,26 @@ bool file_getl(ang_file *f, char *buf, size_t len)
 	while (i < max_len) {
 		char c;
 
-		if (!file_readc(f, &b)) {
+		if (!file_fill(f)) {
 			buf[i] = '\0';
 			return (i == 0) ? false : true;
 		}
 
-		c = (char) b;
+		/* Copy plain text up to the next line end, CR or tab at once */
+		if (!seen_cr) {
+			const char *start = f->rbuf + f->rpos, *stop;
+			size_t n = MIN(f->rlen - f->rpos, max_len - i);
+
+			if ((stop = memchr(start, '\n', n))) n = stop - start;
+			if ((stop = memchr(start, '\r', n))) n = stop - start;
+			if ((stop = memchr(start, '\t', n))) n = stop - start;
+			memcpy(buf + i, start, n);
+			i += n;
+			f->rpos += n;
+			if (f->rpos == f->rlen || i == max_len) continue;
+		}
+
+		c = f->rbuf[f->rpos++];
 
 		if (c == '\r') {
 			seen_cr = true;
@@ -1171,7 +1289,7 @@ bool file_getl(ang_file *f, char *buf, size_t len)
 		}
 
 		if (seen_cr && c != '\n') {
-			fseek(f->fh, -1, SEEK_CUR);
+			f->rpos--;
 			buf[i] = '\0';
 			return true;
 		}
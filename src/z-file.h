@@ -192,6 +192,15 @@ bool file_newer(const char *first, const char *second);
  */
 ang_file *file_open(const char *buf, file_mode mode, file_type ftype);
 
+/**
+ * Create a temporary file, open for both reading and writing, which is
+ * removed when it is closed or the program ends.  Use file_seek() when
+ * switching between reading and writing.
+ *
+ * On any kind of error, this function returns NULL.
+ */
+ang_file *file_temp(void);
+
 
 /**
  * Platform hook for file_open.  Used to set filetypes.
@@ -254,6 +263,18 @@ bool file_vputf(ang_file *f, const char *fmt, va_list vp);
  */
 bool file_skip(ang_file *f, int bytes);
 
+/**
+ * Return the position in file 'f', counted in bytes from the start.
+ * \returns The position; -1 on error
+ */
+long file_tell(ang_file *f);
+
+/**
+ * Move to 'pos' bytes from the start of file 'f'.
+ * \returns true if successful, false otherwise.
+ */
+bool file_seek(ang_file *f, long pos);
+
 /**
  * Reads n bytes from file 'f' into buffer 'buf'.
  * \returns Number of bytes read; -1 on error
@@ -268,6 +289,22 @@ int file_read(ang_file *f, char *buf, size_t n);
  */
 bool file_write(ang_file *f, const char *buf, size_t n);
 
+/**
+ * Pass anything written to `f` and still held in memory to the operating
+ * system.
+ *
+ * Returns true if successful, false otherwise.
+ */
+bool file_flush(ang_file *f);
+
+/**
+ * Like file_flush(), but also wait until the operating system has put what
+ * was written to `f` on disk where it is able to say when that is done.
+ *
+ * Returns true if successful, false otherwise.
+ */
+bool file_sync(ang_file *f);
+
 /**
  * Read a byte from the file represented by `f` and place it at the location
  * specified by 'b'.
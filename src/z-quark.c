@@ -22,17 +22,79 @@
 #include "z-quark.h"
 #include "init.h"
 
+/**
+ * The text of the quarks is kept in blocks which are never moved, so strings
+ * returned by quark_str() stay valid until quarks_free().  A string too long
+ * for a block gets a block of its own.
+ */
+struct quark_block {
+	struct quark_block *next;
+	size_t used;
+	size_t size;
+	char *text;
+};
+
+static struct quark_block *blocks;
 static char **quarks;
 static size_t nr_quarks = 1;
 static size_t alloc_quarks = 0;
 
+/* Open addressing table of quarks by hash; 0 marks an empty slot */
+static quark_t *table;
+static size_t table_mask;
+
 #define QUARKS_INIT	16
+#define QUARK_BLOCK_SIZE	4096
+
+static size_t quark_hash(const char *str)
+{
+	uint32_t h = 2166136261u;
+
+	while (*str) {
+		h ^= (unsigned char)*str++;
+		h *= 16777619u;
+	}
+	return h;
+}
+
+/**
+ * Copy str into a block, returning the copy
+ */
+static char *quark_text(const char *str)
+{
+	size_t len = strlen(str) + 1;
+	char *text;
+
+	if (!blocks || blocks->size - blocks->used < len) {
+		struct quark_block *block = mem_zalloc(sizeof(*block));
+
+		block->size = MAX(len, QUARK_BLOCK_SIZE);
+		block->text = mem_alloc(block->size);
+		block->next = blocks;
+		blocks = block;
+	}
+
+	text = blocks->text + blocks->used;
+	memcpy(text, str, len);
+	blocks->used += len;
+	return text;
+}
+
+static void table_insert(quark_t q)
+{
+	size_t i = quark_hash(quarks[q]);
+
+	while (table[i & table_mask]) i++;
+	table[i & table_mask] = q;
+}
 
 quark_t quark_add(const char *str)
 {
 	quark_t q;
+	size_t i;
 
-	for (q = 1; q < nr_quarks; q++) {
+	for (i = quark_hash(str); table[i & table_mask]; i++) {
+		q = table[i & table_mask];
 		if (streq(quarks[q], str))
 			return q;
 	}
@@ -43,7 +105,18 @@ quark_t quark_add(const char *str)
 	}
 
 	q = nr_quarks++;
-	quarks[q] = string_make(str);
+	quarks[q] = quark_text(str);
+
+	/* Keep the table at most half full */
+	if (2 * nr_quarks > table_mask + 1) {
+		mem_free(table);
+		table_mask = 2 * table_mask + 1;
+		table = mem_zalloc((table_mask + 1) * sizeof(quark_t));
+		for (i = 1; i < nr_quarks; i++)
+			table_insert(i);
+	} else {
+		table_insert(q);
+	}
 
 	return q;
 }
@@ -58,16 +131,23 @@ void quarks_init(void)
 	nr_quarks = 1;
 	alloc_quarks = QUARKS_INIT;
 	quarks = mem_zalloc(alloc_quarks * sizeof(char*));
+	table_mask = 2 * QUARKS_INIT - 1;
+	table = mem_zalloc((table_mask + 1) * sizeof(quark_t));
+	blocks = NULL;
 }
 
 void quarks_free(void)
 {
-	size_t i;
+	while (blocks) {
+		struct quark_block *next = blocks->next;
 
-	/* quarks[0] is special */
-	for (i = 1; i < nr_quarks; i++)
-		string_free(quarks[i]);
+		mem_free(blocks->text);
+		mem_free(blocks);
+		blocks = next;
+	}
 
+	mem_free(table);
+	table = NULL;
 	mem_free(quarks);
 }
 
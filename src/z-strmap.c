@@ -0,0 +1,173 @@
+/**
+ * \file z-strmap.c
+ * \brief Hash table from strings to pointers
+ *
+ * This work is free software; you can redistribute it and/or modify it
+ * under the terms of either:
+ *
+ * a) the GNU General Public License as published by the Free Software
+ *    Foundation, version 2, or
+ *
+ * b) the "Angband licence":
+ *    This software may be copied and distributed for educational, research,
+ *    and not for profit purposes provided that this copyright and statement
+ *    are included in all such copies.  Other copyrights may also apply.
+ */
+
+#include "z-strmap.h"
+#include "z-util.h"
+#include "z-virt.h"
+
+/**
+ * The table uses open addressing with linear probing, and is kept at most
+ * half full so probe runs stay short.
+ */
+#define STRMAP_INIT	16
+
+struct strmap_entry {
+	char *key;
+	void *value;
+	uint32_t hash;
+};
+
+struct strmap {
+	struct strmap_entry *entries;
+	size_t size;
+	size_t len;
+	bool nocase;
+};
+
+static uint32_t strmap_hash(const struct strmap *m, const char *key)
+{
+	uint32_t hash = 0x811c9dc5;
+
+	for (; *key; key++) {
+		unsigned char c = (unsigned char)*key;
+		if (m->nocase) c = (unsigned char)toupper(c);
+		hash = (hash ^ c) * 0x01000193;
+	}
+	return hash;
+}
+
+/**
+ * Find the entry for key, or the empty entry where it would go.
+ */
+static struct strmap_entry *strmap_find(const struct strmap *m,
+		const char *key, uint32_t hash)
+{
+	size_t i = hash & (m->size - 1);
+
+	while (m->entries[i].key) {
+		struct strmap_entry *e = &m->entries[i];
+		if (e->hash == hash && (m->nocase ? !my_stricmp(e->key, key)
+				: streq(e->key, key)))
+			break;
+		i = (i + 1) & (m->size - 1);
+	}
+	return &m->entries[i];
+}
+
+static void strmap_grow(struct strmap *m)
+{
+	struct strmap_entry *old = m->entries;
+	size_t old_size = m->size, i;
+
+	m->size *= 2;
+	m->entries = mem_zalloc(m->size * sizeof(*m->entries));
+	for (i = 0; i < old_size; i++) {
+		if (old[i].key)
+			*strmap_find(m, old[i].key, old[i].hash) = old[i];
+	}
+	mem_free(old);
+}
+
+/**
+ * Make a new, empty map.
+ */
+struct strmap *strmap_new(bool nocase)
+{
+	struct strmap *m = mem_zalloc(sizeof(*m));
+
+	m->size = STRMAP_INIT;
+	m->entries = mem_zalloc(m->size * sizeof(*m->entries));
+	m->nocase = nocase;
+	return m;
+}
+
+/**
+ * Free a map and its copies of the keys.
+ */
+void strmap_free(struct strmap *m)
+{
+	size_t i;
+
+	if (!m) return;
+	for (i = 0; i < m->size; i++)
+		string_free(m->entries[i].key);
+	mem_free(m->entries);
+	mem_free(m);
+}
+
+/**
+ * Add key with the given value.  If the map already has the key, it keeps
+ * the value it has and false is returned.
+ */
+bool strmap_add(struct strmap *m, const char *key, void *value)
+{
+	uint32_t hash = strmap_hash(m, key);
+	struct strmap_entry *e = strmap_find(m, key, hash);
+
+	if (e->key) return false;
+	e->key = string_make(key);
+	e->value = value;
+	e->hash = hash;
+	if (++m->len * 2 > m->size) strmap_grow(m);
+	return true;
+}
+
+/**
+ * Return the value for key, or NULL if the map doesn't have it.
+ */
+void *strmap_get(const struct strmap *m, const char *key)
+{
+	return strmap_find(m, key, strmap_hash(m, key))->value;
+}
+
+/**
+ * Remove key from the map.  Returns the value it had, or NULL if the map
+ * didn't have it.
+ */
+void *strmap_remove(struct strmap *m, const char *key)
+{
+	struct strmap_entry *e = strmap_find(m, key, strmap_hash(m, key));
+	size_t mask = m->size - 1, gap, i;
+	void *value = e->value;
+
+	if (!e->key) return NULL;
+	string_free(e->key);
+	m->len--;
+
+	/*
+	 * Move back any later entry of the probe run which may, to keep every
+	 * entry reachable from where its hash puts it
+	 */
+	gap = e - m->entries;
+	for (i = (gap + 1) & mask; m->entries[i].key; i = (i + 1) & mask) {
+		size_t home = m->entries[i].hash & mask;
+
+		/* Leave entries whose home is after the gap */
+		if (((i - home) & mask) < ((i - gap) & mask)) continue;
+		m->entries[gap] = m->entries[i];
+		gap = i;
+	}
+	memset(&m->entries[gap], 0, sizeof(m->entries[gap]));
+	return value;
+}
+
+/**
+ * Return the number of keys in the map.
+ */
+size_t strmap_len(const struct strmap *m)
+{
+	return m->len;
+}
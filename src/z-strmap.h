@@ -0,0 +1,35 @@
+/**
+ * \file z-strmap.h
+ * \brief Hash table from strings to pointers
+ *
+ * This work is free software; you can redistribute it and/or modify it
+ * under the terms of either:
+ *
+ * a) the GNU General Public License as published by the Free Software
+ *    Foundation, version 2, or
+ *
+ * b) the "Angband licence":
+ *    This software may be copied and distributed for educational, research,
+ *    and not for profit purposes provided that this copyright and statement
+ *    are included in all such copies.  Other copyrights may also apply.
+ */
+
+#ifndef INCLUDED_Z_STRMAP_H
+#define INCLUDED_Z_STRMAP_H
+
+#include "h-basic.h"
+
+/**
+ * A map from strings to non-NULL pointers.  Keys are copied when added.  A
+ * map made with nocase set compares keys as my_stricmp() does.
+ */
+struct strmap;
+
+struct strmap *strmap_new(bool nocase);
+void strmap_free(struct strmap *m);
+bool strmap_add(struct strmap *m, const char *key, void *value);
+void *strmap_get(const struct strmap *m, const char *key);
+void *strmap_remove(struct strmap *m, const char *key);
+size_t strmap_len(const struct strmap *m);
+
+#endif /* INCLUDED_Z_STRMAP_H */